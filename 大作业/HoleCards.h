@@ -26,11 +26,27 @@ namespace Poker {
             }
         }
 
+        // ֱӽָ
+        void receiveCards(CardSet cards) {
+            if (cards_.size() >= 2) {
+                throw std::logic_error("Hole cards already received");
+            }
+            if (cards.size() != 2) {
+                throw std::invalid_argument("Hole cards must be exactly two cards");
+            }
+            cards_ = cards.toCards();
+        }
+
         // ȡϢֻ
         const std::vector<Card>& getCards() const {
             return cards_;
         }
 
+        // Ƶλ
+        CardSet getCardSet() const {
+            return CardSet::of(cards_);
+        }
+
         // ֤Ƿѷ
         bool hasCards() const {
             return cards_.size() == 2;
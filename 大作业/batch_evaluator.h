@@ -0,0 +1,284 @@
+#ifndef BATCH_EVALUATOR_H
+#define BATCH_EVALUATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "poker.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define POKER_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(POKER_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define POKER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define POKER_TARGET_AVX2
+#endif
+
+namespace rules {
+
+    // ṹ鲼ֵһƣ i Ƶֻɫֱ suit(0..3)[i]
+    class HandBatch {
+    public:
+        void reserve(size_t n) {
+            for (auto& s : suits_) s.reserve(n);
+        }
+
+        void clear() {
+            for (auto& s : suits_) s.clear();
+        }
+
+        void push(CardSet hand) {
+            for (int s = 0; s < 4; ++s) suits_[s].push_back(hand.suitMask(s));
+        }
+
+        size_t size() const { return suits_[0].size(); }
+        const uint16_t* suit(int s) const { return suits_[s].data(); }
+
+    private:
+        std::vector<uint16_t> suits_[4];
+    };
+
+    // ÿ7ţ HandStrength::value()
+    // ֧ AVX2 ʱһδ8ƣͬһλͲ
+    class BatchEvaluator {
+    public:
+        enum class Kernel { Auto, Scalar, Avx2 };
+
+        static void evaluate(const HandBatch& batch, uint32_t* out, Kernel kernel = Kernel::Auto) {
+            const uint16_t* suits[4] = { batch.suit(0), batch.suit(1), batch.suit(2), batch.suit(3) };
+            evaluate(suits, batch.size(), out, kernel);
+        }
+
+        static void evaluate(const uint16_t* const suits[4], size_t n, uint32_t* out,
+            Kernel kernel = Kernel::Auto) {
+            const Tables& t = tables();
+            size_t done = 0;
+#if defined(POKER_BATCH_X86)
+            if (kernel != Kernel::Scalar && avx2Supported()) {
+                done = evaluateAvx2(t, suits, n, out);
+            }
+#else
+            (void)kernel;
+#endif
+            for (size_t i = done; i < n; ++i) {
+                out[i] = evaluateOne(t, suits[0][i], suits[1][i], suits[2][i], suits[3][i]);
+            }
+        }
+
+        static bool avx2Supported() {
+#if defined(POKER_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+#elif defined(POKER_BATCH_X86) && defined(_MSC_VER)
+            static const bool supported = detectAvx2();
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        struct Tables {
+            std::vector<uint32_t> top;       // 5 HandStrength ߽λô
+            std::vector<uint32_t> straight;  // ˳ӶƵûΪ0
+            std::vector<uint32_t> flush;     // ͬͬ˳5Ϊ0
+        };
+
+        static const Tables& tables() {
+            static const Tables t = buildTables();
+            return t;
+        }
+
+        static Tables buildTables() {
+            Tables t;
+            t.top.assign(1 << 13, 0);
+            t.straight.assign(1 << 13, 0);
+            t.flush.assign(1 << 13, 0);
+            for (uint32_t mask = 0; mask < (1u << 13); ++mask) {
+                int shift = 16;
+                for (int r = 12; r >= 0 && shift >= 0; --r) {
+                    if (mask & (1u << r)) {
+                        t.top[mask] |= static_cast<uint32_t>(r + 2) << shift;
+                        shift -= 4;
+                    }
+                }
+
+                uint32_t m = (mask << 1) | ((mask >> 12) & 1);  // A ͬʱС
+                uint32_t run = m & (m << 1) & (m << 2) & (m << 3) & (m << 4);
+                t.straight[mask] = run ? static_cast<uint32_t>(highestBit(run) + 1) : 0;
+
+                int bits = bitCount(mask);
+                if (bits >= 5 && bits <= FastEvaluator::MAX_CARDS) {
+                    t.flush[mask] = FastEvaluator::score(CardSet(mask));
+                }
+            }
+            return t;
+        }
+
+        static uint32_t rankBit(uint32_t value) {
+            return value ? 1u << (value - 2) : 0;
+        }
+
+        // ͵ĺѡȡֵͼΪ0λߴֵս
+        static uint32_t evaluateOne(const Tables& t, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3) {
+            uint32_t any = s0 | s1 | s2 | s3;
+            uint32_t two = (s0 & s1) | (s2 & s3) | ((s0 | s1) & (s2 | s3));
+            uint32_t three = ((s0 & s1) & (s2 | s3)) | ((s2 & s3) & (s0 | s1));
+            uint32_t four = s0 & s1 & s2 & s3;
+
+            uint32_t best = std::max(std::max(t.flush[s0], t.flush[s1]), std::max(t.flush[s2], t.flush[s3]));
+            best = std::max(best, t.top[any]);  // 
+
+            uint32_t p1 = t.top[two] >> 16;
+            if (p1) {
+                uint32_t rest = any & ~rankBit(p1);
+                best = std::max(best, category(HandRank::ONE_PAIR) | p1 << 16 | ((t.top[rest] >> 4) & 0xFFF0));
+                uint32_t p2 = t.top[two & ~rankBit(p1)] >> 16;
+                if (p2) {
+                    uint32_t kicker = t.top[rest & ~rankBit(p2)] >> 16;
+                    best = std::max(best, category(HandRank::TWO_PAIR) | p1 << 16 | p2 << 12 | kicker << 8);
+                }
+            }
+
+            uint32_t trips = t.top[three] >> 16;
+            if (trips) {
+                uint32_t rest = any & ~rankBit(trips);
+                best = std::max(best, category(HandRank::THREE_OF_A_KIND) | trips << 16 | ((t.top[rest] >> 4) & 0xFF00));
+                uint32_t pair = t.top[two & ~rankBit(trips)] >> 16;
+                if (pair) best = std::max(best, category(HandRank::FULL_HOUSE) | trips << 16 | pair << 12);
+            }
+
+            if (t.straight[any]) best = std::max(best, category(HandRank::STRAIGHT) | t.straight[any] << 16);
+
+            uint32_t quads = t.top[four] >> 16;
+            if (quads) {
+                uint32_t kicker = t.top[any & ~rankBit(quads)] >> 16;
+                best = std::max(best, category(HandRank::FOUR_OF_A_KIND) | quads << 16 | kicker << 12);
+            }
+            return best;
+        }
+
+        static uint32_t category(HandRank rank) {
+            return static_cast<uint32_t>(rank) << 20;
+        }
+
+#if defined(POKER_BATCH_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+        static bool detectAvx2() {
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        }
+#endif
+
+        static POKER_TARGET_AVX2 __m256i gather(const int* table, __m256i idx) {
+            return _mm256_i32gather_epi32(table, idx, 4);
+        }
+
+        // ĵֵ
+        static POKER_TARGET_AVX2 __m256i hiRank(const int* top, __m256i mask) {
+            return _mm256_srli_epi32(gather(top, mask), 16);
+        }
+
+        // ֵӦλֵΪ0ʱλ31Ϊ0
+        static POKER_TARGET_AVX2 __m256i rankBit(__m256i v) {
+            return _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_sub_epi32(v, _mm256_set1_epi32(2)));
+        }
+
+        // v 0ͨ valueΪ0
+        static POKER_TARGET_AVX2 __m256i when(__m256i v, __m256i value) {
+            return _mm256_andnot_si256(_mm256_cmpeq_epi32(v, _mm256_setzero_si256()), value);
+        }
+
+        static POKER_TARGET_AVX2 __m256i cat(HandRank rank) {
+            return _mm256_set1_epi32(static_cast<int>(category(rank)));
+        }
+
+        //  evaluateOne ͬļ㣬8һ飻Ѵ
+        static POKER_TARGET_AVX2 size_t evaluateAvx2(const Tables& t, const uint16_t* const suits[4], size_t n, uint32_t* out) {
+            const int* top = reinterpret_cast<const int*>(t.top.data());
+            const int* straight = reinterpret_cast<const int*>(t.straight.data());
+            const int* flush = reinterpret_cast<const int*>(t.flush.data());
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i s0 = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(suits[0] + i)));
+                __m256i s1 = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(suits[1] + i)));
+                __m256i s2 = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(suits[2] + i)));
+                __m256i s3 = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(suits[3] + i)));
+
+                __m256i lo = _mm256_or_si256(s0, s1);
+                __m256i hiPair = _mm256_or_si256(s2, s3);
+                __m256i both01 = _mm256_and_si256(s0, s1);
+                __m256i both23 = _mm256_and_si256(s2, s3);
+                __m256i any = _mm256_or_si256(lo, hiPair);
+                __m256i two = _mm256_or_si256(_mm256_or_si256(both01, both23), _mm256_and_si256(lo, hiPair));
+                __m256i three = _mm256_or_si256(_mm256_and_si256(both01, hiPair), _mm256_and_si256(both23, lo));
+                __m256i four = _mm256_and_si256(both01, both23);
+
+                __m256i best = _mm256_max_epu32(
+                    _mm256_max_epu32(gather(flush, s0), gather(flush, s1)),
+                    _mm256_max_epu32(gather(flush, s2), gather(flush, s3)));
+                best = _mm256_max_epu32(best, gather(top, any));
+
+                // һԡ
+                __m256i p1 = hiRank(top, two);
+                __m256i rest = _mm256_andnot_si256(rankBit(p1), any);
+                __m256i pair = _mm256_or_si256(_mm256_or_si256(cat(HandRank::ONE_PAIR), _mm256_slli_epi32(p1, 16)),
+                    _mm256_and_si256(_mm256_srli_epi32(gather(top, rest), 4), _mm256_set1_epi32(0xFFF0)));
+                best = _mm256_max_epu32(best, when(p1, pair));
+
+                __m256i p2 = hiRank(top, _mm256_andnot_si256(rankBit(p1), two));
+                __m256i kick2 = hiRank(top, _mm256_andnot_si256(rankBit(p2), rest));
+                __m256i twoPair = _mm256_or_si256(
+                    _mm256_or_si256(cat(HandRank::TWO_PAIR), _mm256_slli_epi32(p1, 16)),
+                    _mm256_or_si256(_mm256_slli_epi32(p2, 12), _mm256_slli_epi32(kick2, 8)));
+                best = _mm256_max_epu32(best, when(p2, twoPair));
+
+                // «
+                __m256i trips = hiRank(top, three);
+                __m256i tripsBit = rankBit(trips);
+                __m256i tripsRest = _mm256_andnot_si256(tripsBit, any);
+                __m256i set = _mm256_or_si256(_mm256_or_si256(cat(HandRank::THREE_OF_A_KIND), _mm256_slli_epi32(trips, 16)),
+                    _mm256_and_si256(_mm256_srli_epi32(gather(top, tripsRest), 4), _mm256_set1_epi32(0xFF00)));
+                best = _mm256_max_epu32(best, when(trips, set));
+
+                __m256i fhPair = hiRank(top, _mm256_andnot_si256(tripsBit, two));
+                __m256i fullHouse = _mm256_or_si256(_mm256_or_si256(cat(HandRank::FULL_HOUSE), _mm256_slli_epi32(trips, 16)),
+                    _mm256_slli_epi32(fhPair, 12));
+                best = _mm256_max_epu32(best, when(trips, when(fhPair, fullHouse)));
+
+                // ˳
+                __m256i high = gather(straight, any);
+                best = _mm256_max_epu32(best, when(high,
+                    _mm256_or_si256(cat(HandRank::STRAIGHT), _mm256_slli_epi32(high, 16))));
+
+                // 
+                __m256i quads = hiRank(top, four);
+                __m256i quadKick = hiRank(top, _mm256_andnot_si256(rankBit(quads), any));
+                __m256i quad = _mm256_or_si256(_mm256_or_si256(cat(HandRank::FOUR_OF_A_KIND), _mm256_slli_epi32(quads, 16)),
+                    _mm256_slli_epi32(quadKick, 12));
+                best = _mm256_max_epu32(best, when(quads, quad));
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), best);
+            }
+            return i;
+        }
+#endif
+    };
+
+}
+
+#endif
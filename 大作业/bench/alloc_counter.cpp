@@ -0,0 +1,19 @@
+﻿#include <cstdlib>
+#include <new>
+#include "alloc_counter.h"
+
+// 统计本线程的堆分配次数
+static thread_local uint64_t allocationCount = 0;
+
+uint64_t threadAllocations() {
+    return allocationCount;
+}
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
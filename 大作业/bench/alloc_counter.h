@@ -0,0 +1,10 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+// ߳ȫ operator new Ĵ滻 operator new  alloc_counter.cpp У
+// 亯ô
+uint64_t threadAllocations();
+
+#endif
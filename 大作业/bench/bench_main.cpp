@@ -0,0 +1,464 @@
+﻿// 热点路径基准测试：评估器、胜者判定、牌堆、发底牌、完整的一手牌模拟和界面重绘
+// 用法：poker_bench [--json] [--seed=N] [--min-time=毫秒] [--max-threads=N]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "poker.h"
+#include "rng.h"
+#include "HoleCards.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+#include "batch_evaluator.h"
+#include "game_engine.h"
+#include "suit_isomorphism.h"
+#include "equity_cache.h"
+#include "incremental_hand.h"
+#include "showdown.h"
+#include "evaluation_cache.h"
+#include "hand_distribution.h"
+#include "outs.h"
+#include "icm.h"
+#include "decision.h"
+#include "renderer.h"
+#include "memory_renderer.h"
+#include "alloc_counter.h"
+
+using namespace Poker;
+using namespace rules;
+
+namespace {
+
+    struct Options {
+        bool json = false;
+        uint64_t seed = 20240601;
+        double minTimeMs = 200;
+        unsigned maxThreads = 0;  // 0 表示到硬件线程数为止
+    };
+
+    struct Result {
+        std::string name;
+        std::string variant;
+        uint64_t ops = 0;
+        double nsPerOp = 0;
+        double allocsPerOp = 0;
+    };
+
+    struct Throughput {
+        unsigned threads = 0;
+        uint64_t hands = 0;
+        double handsPerSec = 0;
+    };
+
+    // 防止被优化掉的结果汇总
+    std::atomic<uint64_t> sink{ 0 };
+
+    const int INPUT_COUNT = 4096;  // 预先生成的输入个数，循环使用
+
+    double elapsedNs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // op(i) 执行第 i 次操作并返回一个值；次数倍增直到运行时间超过 minTimeMs
+    template <class Op>
+    Result measure(const Options& options, const std::string& name, const std::string& variant, Op op) {
+        uint64_t n = 1;
+        uint64_t local = 0;
+        for (uint64_t i = 0; i < 16; ++i) local += op(i);  // 预热，构建静态表
+
+        while (true) {
+            uint64_t allocs = threadAllocations();
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < n; ++i) local += op(i);
+            double ns = elapsedNs(start);
+            allocs = threadAllocations() - allocs;
+            if (ns >= options.minTimeMs * 1e6 || n >= (1ULL << 40)) {
+                sink += local;
+                Result r;
+                r.name = name;
+                r.variant = variant;
+                r.ops = n;
+                r.nsPerOp = ns / n;
+                r.allocsPerOp = static_cast<double>(allocs) / n;
+                return r;
+            }
+            n *= 2;
+        }
+    }
+
+    std::vector<std::vector<Card>> randomHands(Xoshiro256& rng, int cards) {
+        std::vector<std::vector<Card>> hands;
+        for (int i = 0; i < INPUT_COUNT; ++i) {
+            Deck deck;
+            std::vector<Card> hand;
+            for (int k = 0; k < cards; ++k) hand.push_back(deck.dealRandom(rng));
+            hands.push_back(hand);
+        }
+        return hands;
+    }
+
+    // 一次摊牌：players 家底牌和5张公共牌
+    struct Showdown {
+        std::vector<CardSet> hands;
+        CardSet board;
+    };
+
+    std::vector<Showdown> randomShowdowns(Xoshiro256& rng, int players) {
+        std::vector<Showdown> showdowns(INPUT_COUNT);
+        for (auto& s : showdowns) {
+            Deck deck;
+            s.board = deck.dealRandomSet(rng, 5);
+            for (int p = 0; p < players; ++p) s.hands.push_back(deck.dealRandomSet(rng, 2));
+        }
+        return showdowns;
+    }
+
+    // 用随机策略打完一手6人桌，返回行动数
+    uint64_t playHand(Xoshiro256& rng, int button) {
+        engine::TableConfig config;
+        config.seats = 6;
+        const int32_t stacks[6] = { 10000, 10000, 10000, 10000, 10000, 10000 };
+        engine::HandState hand = engine::GameEngine::startHand(config, stacks, button, rng);
+        uint64_t actions = 0;
+        while (!hand.finished()) {
+            engine::LegalActions legal = engine::GameEngine::legalActions(hand);
+            uint32_t roll = rng.bounded(100);
+            engine::Action action;
+            if (roll < 15 && !legal.canCheck) action = engine::Action::fold();
+            else if (roll < 85 || !legal.canRaise) action = legal.canCheck ? engine::Action::check() : engine::Action::call();
+            else if (roll < 98) action = engine::Action::raiseTo(legal.minRaiseTo);
+            else action = engine::Action::allIn();
+            engine::GameEngine::apply(hand, action);
+            actions++;
+        }
+        return actions + hand.seat[0].stack;
+    }
+
+    // 与图形界面布局相同的一帧：4张底牌、5张公共牌、3个按钮和文字
+    render::Scene tableScene(int boardSlot) {
+        const int w = 120, h = 160;
+        render::Scene scene;
+        scene.add(render::Item::label(1, render::Rect(50, 50, 650, 70), L"chips $1000  pot $200  chips $1000", render::rgb(255, 255, 255)));
+        scene.add(render::Item::sprite(10, render::AtlasLayout::CARD_BACK, 600, 100, w, h));
+        scene.add(render::Item::sprite(11, render::AtlasLayout::CARD_BACK, 800, 100, w, h));
+        for (int i = 0; i < 5; ++i) scene.add(render::Item::sprite(20 + i, i == 4 ? boardSlot : i, 400 + i * 150, 300, w, h));
+        scene.add(render::Item::sprite(30, 16, 600, 600, w, h));
+        scene.add(render::Item::sprite(31, 17, 800, 600, w, h));
+        for (int i = 0; i < 3; ++i) {
+            scene.add(render::Item::button(40 + i, render::Rect(200 + i * 250, 750, 400 + i * 250, 830), render::rgb(70, 130, 180)));
+            scene.add(render::Item::label(43 + i, render::Rect(250 + i * 250, 770, 400 + i * 250, 790), L"button", render::rgb(255, 255, 255)));
+        }
+        return scene;
+    }
+
+    std::vector<Result> runBenchmarks(const Options& options) {
+        std::vector<Result> results;
+        Xoshiro256 rng(options.seed);
+        const uint64_t mask = INPUT_COUNT - 1;
+
+        for (int cards = 5; cards <= 7; ++cards) {
+            auto hands = randomHands(rng, cards);
+            std::vector<CardSet> sets;
+            for (const auto& h : hands) sets.push_back(CardSet::of(h));
+            std::string variant = std::to_string(cards) + " cards";
+            results.push_back(measure(options, "Evaluator::evaluateHand(vector)", variant, [&](uint64_t i) {
+                return static_cast<uint64_t>(Evaluator::evaluateHand(hands[i & mask]).value());
+            }));
+            results.push_back(measure(options, "Evaluator::evaluateHand(CardSet)", variant, [&](uint64_t i) {
+                return static_cast<uint64_t>(Evaluator::evaluateHand(sets[i & mask]).value());
+            }));
+            results.push_back(measure(options, "FastEvaluator::score(CardSet)", variant, [&](uint64_t i) {
+                return static_cast<uint64_t>(FastEvaluator::score(sets[i & mask]));
+            }));
+        }
+
+        // 一大批 7 张牌的批量评估，每次处理整批，结果折算为每手牌；对照上面的 FastEvaluator::score
+        const size_t BATCH_HANDS = 1 << 16;
+        Xoshiro256 batchRng(options.seed, 3);
+        HandBatch batch;
+        batch.reserve(BATCH_HANDS);
+        for (size_t i = 0; i < BATCH_HANDS; ++i) {
+            Deck deck;
+            batch.push(deck.dealRandomSet(batchRng, 7));
+        }
+        std::vector<uint32_t> batchOut(BATCH_HANDS);
+        auto measureBatch = [&](BatchEvaluator::Kernel kernel, const std::string& variant) {
+            Result r = measure(options, "BatchEvaluator::evaluate", variant, [&](uint64_t i) {
+                BatchEvaluator::evaluate(batch, batchOut.data(), kernel);
+                return static_cast<uint64_t>(batchOut[i & (BATCH_HANDS - 1)]);
+            });
+            r.ops *= BATCH_HANDS;
+            r.nsPerOp /= BATCH_HANDS;
+            r.allocsPerOp /= BATCH_HANDS;
+            results.push_back(r);
+        };
+        measureBatch(BatchEvaluator::Kernel::Scalar, "scalar, 7 cards");
+        // 不支持 AVX2 时 Avx2 内核会退回标量实现，不单独列出
+        if (BatchEvaluator::avx2Supported()) measureBatch(BatchEvaluator::Kernel::Avx2, "avx2, 7 cards");
+
+        for (int players = 2; players <= 10; ++players) {
+            auto showdowns = randomShowdowns(rng, players);
+            results.push_back(measure(options, "Evaluator::determineWinners", std::to_string(players) + " players",
+                [&](uint64_t i) {
+                    const Showdown& s = showdowns[i & mask];
+                    return static_cast<uint64_t>(Evaluator::determineWinners(s.hands, s.board).front());
+                }));
+            results.push_back(measure(options, "Showdown::rank", std::to_string(players) + " players",
+                [&](uint64_t i) {
+                    const Showdown& s = showdowns[i & mask];
+                    ShowdownResult ranking;
+                    rules::Showdown::rank(s.hands.data(), players, s.board, ranking);
+                    return static_cast<uint64_t>(ranking.tier[ranking.tiers - 1]);
+                }));
+        }
+
+        Xoshiro256 deckRng(options.seed, 1);
+        results.push_back(measure(options, "Deck::shuffle", "52 cards", [&](uint64_t) {
+            Deck deck;
+            deck.shuffle(deckRng);
+            return static_cast<uint64_t>(deck.deal().index());
+        }));
+        results.push_back(measure(options, "Deck::deal", "52 cards", [&](uint64_t) {
+            Deck deck;
+            uint64_t total = 0;
+            while (!deck.isEmpty()) total += deck.deal().index();
+            return total;
+        }));
+        results.push_back(measure(options, "Deck::dealRandom", "9 cards", [&](uint64_t) {
+            Deck deck;
+            return deck.dealRandomSet(deckRng, 9).bits();
+        }));
+        results.push_back(measure(options, "HoleCards::receiveCards", "shuffled deck", [&](uint64_t) {
+            Deck deck;
+            deck.shuffle(deckRng);
+            HoleCards hand;
+            hand.receiveCards(deck);
+            return static_cast<uint64_t>(hand.getCards()[0].index());
+        }));
+
+        Xoshiro256 handRng(options.seed, 2);
+        results.push_back(measure(options, "GameEngine full hand", "6 seats", [&](uint64_t i) {
+            return playHand(handRng, static_cast<int>(i % 6));
+        }));
+
+        // 花色规范化，以及胜率缓存全部命中时的查询
+        std::vector<std::pair<CardSet, CardSet>> spots;
+        for (const auto& h : randomHands(rng, 7)) {
+            spots.emplace_back(CardSet::of({ h[0], h[1] }), CardSet::of({ h[2], h[3], h[4] }));
+        }
+        results.push_back(measure(options, "SuitIsomorphism::index", "hole + flop", [&](uint64_t i) {
+            return SuitIsomorphism::index(spots[i & mask].first, spots[i & mask].second);
+        }));
+        EquityCache cache;
+        CachedEquity cached;
+        cached.trials = static_cast<uint32_t>(EquityOptions().maxTrials);   // 精度满足默认查询
+        for (uint64_t i = 0; i <= mask; ++i) {
+            cache.store(SuitIsomorphism::index(spots[i].first, spots[i].second), 1, cached);
+        }
+        results.push_back(measure(options, "EquityCache::equity", "hit", [&](uint64_t i) {
+            return static_cast<uint64_t>(cache.equity(spots[i & mask].first, spots[i & mask].second, 1).trials);
+        }));
+
+        // 底牌建立后逐街加入公共牌，每街更新牌力和听牌
+        std::vector<std::vector<Card>> streets = randomHands(rng, 7);
+        std::vector<std::pair<CardSet, CardSet>> holeFlops;
+        for (const auto& h : streets) holeFlops.emplace_back(CardSet::of({ h[0], h[1] }), CardSet::of({ h[2], h[3], h[4] }));
+        results.push_back(measure(options, "IncrementalHand hole to river", "3 updates", [&](uint64_t i) {
+            IncrementalHand hand(holeFlops[i & mask].first);
+            hand.add(holeFlops[i & mask].second);
+            uint64_t sum = hand.score() + hand.draws().straightRanks;
+            hand.add(streets[i & mask][5]);
+            sum += hand.score() + hand.draws().straightRanks;
+            hand.add(streets[i & mask][6]);
+            return sum + hand.score();
+        }));
+
+        // 牌力记忆表全部命中时的查询，对照上面的 Evaluator::evaluateHand(CardSet)
+        std::vector<CardSet> sevens;
+        for (const auto& h : streets) sevens.push_back(CardSet::of(h));
+        EvaluationCache evalCache;
+        for (CardSet c : sevens) evalCache.evaluateHand(c);
+        results.push_back(measure(options, "EvaluationCache::evaluateHand", "hit, 7 cards", [&](uint64_t i) {
+            return static_cast<uint64_t>(evalCache.evaluateHand(sevens[i & mask]).value());
+        }));
+
+        // 牌型分布的完整枚举：翻牌后 1081 种发牌（单线程），翻牌前 C(50,5) 种（全部线程）
+        results.push_back(measure(options, "HandDistribution::run", "flop", [&](uint64_t i) {
+            return HandDistribution::run(holeFlops[i & mask].first, holeFlops[i & mask].second).counts[1];
+        }));
+        results.push_back(measure(options, "HandDistribution::run", "preflop", [&](uint64_t i) {
+            return HandDistribution::run(holeFlops[i & mask].first, CardSet()).counts[1];
+        }));
+
+        // 翻牌后的出牌：只知道自己的底牌，以及已知对手底牌的单挑
+        std::vector<std::array<CardSet, 2>> duels;
+        for (const auto& h : streets) duels.push_back({ { CardSet::of({ h[0], h[1] }), CardSet::of({ h[5], h[6] }) } });
+        results.push_back(measure(options, "Outs::compute", "hero only, flop", [&](uint64_t i) {
+            OutsResult outs;
+            Outs::compute(&duels[i & mask][0], 1, holeFlops[i & mask].second, outs);
+            return static_cast<uint64_t>(outs.players[0].count());
+        }));
+        results.push_back(measure(options, "Outs::compute", "heads-up, flop", [&](uint64_t i) {
+            OutsResult outs;
+            Outs::compute(duels[i & mask].data(), 2, holeFlops[i & mask].second, outs);
+            return static_cast<uint64_t>(outs.players[0].count() + outs.players[1].count());
+        }));
+
+        // 20 人的 ICM：前三名付奖只涉及 211 个集合，全部付奖时为 2^20 个
+        std::vector<double> icmStacks, icmPayouts, icmOut(20);
+        for (int i = 0; i < 20; ++i) {
+            icmStacks.push_back(1000 + 137 * i);
+            icmPayouts.push_back(20 - i);
+        }
+        IcmCalculator icmTop3({ 50, 30, 20 }), icmFull(icmPayouts);
+        results.push_back(measure(options, "IcmCalculator::equity", "20 players, 3 paid", [&](uint64_t i) {
+            icmTop3.equity(icmStacks.data(), 20, icmOut.data());
+            return static_cast<uint64_t>(icmOut[i % 20]);
+        }));
+        results.push_back(measure(options, "IcmCalculator::equity", "20 players, all paid", [&](uint64_t i) {
+            icmFull.equity(icmStacks.data(), 20, icmOut.data());
+            return static_cast<uint64_t>(icmOut[i % 20]);
+        }));
+
+        // 限时决策：翻牌前面对加注，耗时应贴近预算
+        ai::DecisionOptions decisionOptions;
+        decisionOptions.budgetUs = 200;
+        ai::AnytimeDecider decider(decisionOptions);
+        engine::TableConfig headsUp;
+        const int32_t deep[2] = { 10000, 10000 };
+        engine::HandState facingRaise = engine::GameEngine::startHand(headsUp, deep, 0, handRng);
+        engine::GameEngine::apply(facingRaise, engine::Action::raiseTo(300));
+        results.push_back(measure(options, "AnytimeDecider::decide", "200 us budget", [&](uint64_t) {
+            return decider.decide(facingRaise, handRng).samples;
+        }));
+
+        // 内存帧缓冲后端上的整帧重绘、无变化帧和只换一张牌的帧
+        render::MemoryRenderer framebuffer(1500, 900, 120, 160);
+        render::Compositor compositor;
+        render::Scene scenes[2] = { tableScene(32), tableScene(33) };
+        results.push_back(measure(options, "Compositor::render", "full frame", [&](uint64_t i) {
+            compositor.invalidate();
+            return static_cast<uint64_t>(compositor.render(framebuffer, scenes[i & 1]).size());
+        }));
+        results.push_back(measure(options, "Compositor::render", "idle frame", [&](uint64_t) {
+            return static_cast<uint64_t>(compositor.render(framebuffer, scenes[0]).size());
+        }));
+        results.push_back(measure(options, "Compositor::render", "one card changed", [&](uint64_t i) {
+            return static_cast<uint64_t>(compositor.render(framebuffer, scenes[i & 1]).size());
+        }));
+        return results;
+    }
+
+    // 每个线程用自己的随机数流连续模拟，统计总手数
+    std::vector<Throughput> runThroughput(const Options& options) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        unsigned maxThreads = options.maxThreads ? options.maxThreads : (hardware ? hardware : 1);
+        std::vector<unsigned> counts;
+        for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+        counts.push_back(maxThreads);
+
+        std::vector<Throughput> results;
+        for (unsigned threads : counts) {
+            std::atomic<bool> stop{ false };
+            std::vector<uint64_t> hands(threads, 0);
+            std::vector<std::thread> workers;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t]() {
+                    Xoshiro256 rng(options.seed, 100 + t);
+                    uint64_t n = 0, local = 0;
+                    while (!stop.load(std::memory_order_relaxed)) {
+                        for (int i = 0; i < 256; ++i) local += playHand(rng, static_cast<int>(n++ % 6));
+                    }
+                    hands[t] = n;
+                    sink += local;
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(options.minTimeMs));
+            stop = true;
+            for (auto& w : workers) w.join();
+            double seconds = elapsedNs(start) / 1e9;
+
+            Throughput r;
+            r.threads = threads;
+            for (uint64_t h : hands) r.hands += h;
+            r.handsPerSec = r.hands / seconds;
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    std::string jsonEscape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    void printText(const Options& options, const std::vector<Result>& results, const std::vector<Throughput>& throughput) {
+        std::printf("seed %llu, min time %.0f ms\n\n", static_cast<unsigned long long>(options.seed), options.minTimeMs);
+        std::printf("%-36s %-14s %12s %12s %14s\n", "benchmark", "variant", "ns/op", "allocs/op", "ops");
+        for (const auto& r : results) {
+            std::printf("%-36s %-14s %12.2f %12.2f %14llu\n", r.name.c_str(), r.variant.c_str(),
+                r.nsPerOp, r.allocsPerOp, static_cast<unsigned long long>(r.ops));
+        }
+        std::printf("\n%-10s %16s\n", "threads", "hands/s");
+        for (const auto& t : throughput) {
+            std::printf("%-10u %16.0f\n", t.threads, t.handsPerSec);
+        }
+    }
+
+    void printJson(const Options& options, const std::vector<Result>& results, const std::vector<Throughput>& throughput) {
+        std::printf("{\n  \"seed\": %llu,\n  \"min_time_ms\": %.0f,\n  \"benchmarks\": [\n",
+            static_cast<unsigned long long>(options.seed), options.minTimeMs);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::printf("    {\"name\": \"%s\", \"variant\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, \"ops\": %llu}%s\n",
+                jsonEscape(r.name).c_str(), jsonEscape(r.variant).c_str(), r.nsPerOp, r.allocsPerOp,
+                static_cast<unsigned long long>(r.ops), i + 1 < results.size() ? "," : "");
+        }
+        std::printf("  ],\n  \"throughput\": [\n");
+        for (size_t i = 0; i < throughput.size(); ++i) {
+            const Throughput& t = throughput[i];
+            std::printf("    {\"threads\": %u, \"hands\": %llu, \"hands_per_sec\": %.0f}%s\n",
+                t.threads, static_cast<unsigned long long>(t.hands), t.handsPerSec,
+                i + 1 < throughput.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    }
+
+    bool parseArgs(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--json") == 0) options.json = true;
+            else if (std::strncmp(arg, "--seed=", 7) == 0) options.seed = std::strtoull(arg + 7, nullptr, 10);
+            else if (std::strncmp(arg, "--min-time=", 11) == 0) options.minTimeMs = std::atof(arg + 11);
+            else if (std::strncmp(arg, "--max-threads=", 14) == 0) options.maxThreads = static_cast<unsigned>(std::atoi(arg + 14));
+            else {
+                std::fprintf(stderr, "usage: %s [--json] [--seed=N] [--min-time=ms] [--max-threads=N]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) return 2;
+
+    std::vector<Result> results = runBenchmarks(options);
+    std::vector<Throughput> throughput = runThroughput(options);
+    if (options.json) printJson(options, results, throughput);
+    else printText(options, results, throughput);
+    return 0;
+}
@@ -0,0 +1,450 @@
+#ifndef CFR_H
+#define CFR_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+#include "rng.h"
+#include "fast_evaluator.h"
+#include "starting_hands.h"
+#include "game_engine.h"
+#include "mapped_file.h"
+#include "preflop_table.h"
+
+// ע CFR Բԣѵɲļʱӳļ
+namespace ai {
+
+    using engine::HandState;
+    using engine::GameEngine;
+    using engine::Action;
+
+    // Call ʾƻעּעע׳صһؼ
+    enum class AbstractAction : uint8_t { Fold, Call, RaiseHalf, RaisePot, AllIn };
+    const int ABSTRACT_ACTIONS = 5;
+
+    // ƺעĳϢ =   ע״̬  
+    //   ע״̬Ƿׯҡּע0-33 ʾ3μϣǷעЧ׳֮ȣ3
+    //   ǰΪ169ƣƺΪпֵܶƵʤʣ10
+    // ÿϢƽ̹й̶±꣬ҪϷڵ
+    class CfrAbstraction {
+    public:
+        static const int PREFLOP_BUCKETS = 169;
+        static const int POSTFLOP_BUCKETS = 10;
+        static const int RAISE_LEVELS = 4;
+        static const int SPR_BUCKETS = 3;
+        static const int BETTING_STATES = 2 * RAISE_LEVELS * 2 * SPR_BUCKETS;
+        static const int RAISE_CAP = 2;   // ּעﵽôֻơעȫ
+
+        static int buckets(int street) { return street == 0 ? PREFLOP_BUCKETS : POSTFLOP_BUCKETS; }
+
+        static int streetOffset(int street) {
+            return street == 0 ? 0 : BETTING_STATES * (PREFLOP_BUCKETS + (street - 1) * POSTFLOP_BUCKETS);
+        }
+
+        static int infosetCount() { return streetOffset(4); }
+
+        static int infoset(int street, int betting, int bucket) {
+            return streetOffset(street) + betting * buckets(street) + bucket;
+        }
+
+        static int bettingState(const HandState& s) {
+            const engine::SeatState& me = s.seat[s.toAct];
+            int32_t opponent = 0;
+            for (int i = 0; i < s.config.seats; ++i) {
+                if (i != s.toAct && s.seat[i].inHand) opponent = std::max(opponent, s.seat[i].stack + s.seat[i].bet - me.bet);
+            }
+            int32_t effective = std::min(me.stack, opponent);
+            int32_t pot = std::max(s.pot(), 1);
+            int spr = effective < pot ? 0 : (effective < 4 * pot ? 1 : 2);
+            int position = s.toAct == s.button ? 1 : 0;
+            int raises = std::min<int>(s.raises, RAISE_LEVELS - 1);
+            int facing = s.currentBet > me.bet ? 1 : 0;
+            return ((position * RAISE_LEVELS + raises) * 2 + facing) * SPR_BUCKETS + spr;
+        }
+
+        // ԼƲͻĶֵƵʤʣƽּһ룩λҹһö
+        static void handStrength(const CardSet* holes, int count, CardSet board, double* out) {
+            rules::FastEvaluator::Accumulator base;
+            for (CardSet rest = board; !rest.empty();) base.add(rest.popFirst());
+            uint32_t own[engine::MAX_SEATS];
+            double wins[engine::MAX_SEATS] = { 0 };
+            uint32_t total[engine::MAX_SEATS] = { 0 };
+            for (int p = 0; p < count; ++p) own[p] = rules::FastEvaluator::score(holes[p] | board);
+
+            uint8_t live[52];
+            int n = 0;
+            for (CardSet rest = CardSet::fullDeck() - board; !rest.empty();) live[n++] = static_cast<uint8_t>(rest.popFirst().index());
+            for (int i = 0; i < n; ++i) {
+                rules::FastEvaluator::Accumulator first = base;
+                first.add(Card::fromIndex(live[i]));
+                for (int j = i + 1; j < n; ++j) {
+                    rules::FastEvaluator::Accumulator acc = first;
+                    acc.add(Card::fromIndex(live[j]));
+                    uint32_t score = rules::FastEvaluator::score(acc);
+                    CardSet opp(1ULL << live[i] | 1ULL << live[j]);
+                    for (int p = 0; p < count; ++p) {
+                        if (!(opp & holes[p]).empty()) continue;
+                        total[p]++;
+                        wins[p] += own[p] > score ? 1.0 : (own[p] == score ? 0.5 : 0.0);
+                    }
+                }
+            }
+            for (int p = 0; p < count; ++p) out[p] = total[p] ? wins[p] / total[p] : 0.5;
+        }
+
+        static int strengthBucket(double strength) {
+            return std::min(static_cast<int>(strength * POSTFLOP_BUCKETS), POSTFLOP_BUCKETS - 1);
+        }
+
+        // ֻѹĹ
+        static int bucket(CardSet hole, CardSet board) {
+            if (board.empty()) return rules::StartingHands::classIndex(hole);
+            double strength;
+            handStrength(&hole, 1, board, &strength);
+            return strengthBucket(strength);
+        }
+
+        // עǰע + ע׳ص fraction ںϷΧ
+        static int32_t raiseAmount(const HandState& s, const engine::LegalActions& legal, double fraction) {
+            int32_t potAfterCall = s.pot() + legal.callAmount;
+            int32_t total = s.currentBet + static_cast<int32_t>(potAfterCall * fraction);
+            return std::max(legal.minRaiseTo, std::min(total, legal.maxRaiseTo));
+        }
+
+        // ǰж߿õĳλ룩ͬļעֻһ
+        static unsigned legalMask(const HandState& s) {
+            engine::LegalActions legal = GameEngine::legalActions(s);
+            unsigned mask = bit(AbstractAction::Call);
+            if (!legal.canCheck) mask |= bit(AbstractAction::Fold);
+            if (legal.canRaise) {
+                mask |= bit(AbstractAction::AllIn);
+                if (s.raises < RAISE_CAP) {
+                    int32_t half = raiseAmount(s, legal, 0.5);
+                    int32_t pot = raiseAmount(s, legal, 1.0);
+                    if (half < legal.maxRaiseTo) mask |= bit(AbstractAction::RaiseHalf);
+                    if (pot < legal.maxRaiseTo && pot > half) mask |= bit(AbstractAction::RaisePot);
+                }
+            }
+            return mask;
+        }
+
+        static Action toAction(const HandState& s, AbstractAction a) {
+            engine::LegalActions legal = GameEngine::legalActions(s);
+            switch (a) {
+            case AbstractAction::Fold:      return Action::fold();
+            case AbstractAction::RaiseHalf: return Action::raiseTo(raiseAmount(s, legal, 0.5));
+            case AbstractAction::RaisePot:  return Action::raiseTo(raiseAmount(s, legal, 1.0));
+            case AbstractAction::AllIn:     return Action::allIn();
+            default:                        return legal.canCheck ? Action::check() : Action::call();
+            }
+        }
+
+        static unsigned bit(AbstractAction a) { return 1u << static_cast<int>(a); }
+    };
+
+    // ļͷ֮ float strategy[infosets][ABSTRACT_ACTIONS]ƽԣδʹϢȫΪ0
+    struct CfrFileHeader {
+        char magic[8];            // "CFRSTRT"
+        uint32_t version;
+        uint32_t actions;
+        uint32_t infosets;
+        uint32_t bettingStates;
+        uint32_t preflopBuckets;
+        uint32_t postflopBuckets;
+        uint64_t iterations;
+        uint64_t seed;
+        uint64_t checksum;        // ݵ FNV-1a 64 λУ
+        uint8_t reserved[8];
+    };
+    static_assert(sizeof(CfrFileHeader) == 64, "CfrFileHeader must be 64 bytes");
+
+    const char CFR_MAGIC[8] = { 'C', 'F', 'R', 'S', 'T', 'R', 'T', 0 };
+    const uint32_t CFR_VERSION = 1;
+
+    struct CfrTrainerOptions {
+        unsigned threads = 0;         // 0 ʾȫ
+        uint64_t seed = 1;
+        engine::TableConfig table;    // 
+        int32_t minStack = 500;       // ÿεĳڸ÷Χǲͬĳ
+        int32_t maxStack = 3000;
+    };
+
+    struct CfrTrainingStats {
+        uint64_t iterations = 0;      // ѵĵ
+        uint64_t nodes = 0;           // ʵľ߽ڵ
+        double seconds = 0;
+        double iterationsPerSecond = 0;
+    };
+
+    // ⲿ MCCFRźֵ CFR+ ضΪǸ
+    // ÿεһƣλΪߣߵĶȫչֺͷֻһΡ
+    // źֵͲۼԤȷƽ̹У߳ضдżʧһθ²Ӱ
+    class CfrTrainer {
+    public:
+        explicit CfrTrainer(const CfrTrainerOptions& options = CfrTrainerOptions())
+            : options_(options),
+            size_(static_cast<size_t>(CfrAbstraction::infosetCount()) * ABSTRACT_ACTIONS),
+            regrets_(new std::atomic<float>[size_]),
+            strategySum_(new std::atomic<float>[size_]) {
+            if (options.table.seats != 2) throw std::invalid_argument("CFR trainer supports heads-up only");
+            if (options.minStack < options.table.bigBlind || options.maxStack < options.minStack) {
+                throw std::invalid_argument("Invalid stack range");
+            }
+            for (size_t i = 0; i < size_; ++i) {
+                regrets_[i].store(0, std::memory_order_relaxed);
+                strategySum_[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        CfrTrainingStats train(uint64_t iterations) {
+            auto start = std::chrono::steady_clock::now();
+            unsigned threadCount = options_.threads ? options_.threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+
+            uint64_t first = iterations_;
+            std::atomic<uint64_t> next{ 0 };
+            std::atomic<uint64_t> nodes{ 0 };
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&]() {
+                    uint64_t visited = 0;
+                    for (uint64_t i = next++; i < iterations; i = next++) {
+                        // ÿεֻӺ͵ž
+                        Xoshiro256 rng(options_.seed, first + i);
+                        iterate(rng, visited);
+                    }
+                    nodes += visited;
+                });
+            }
+            for (auto& w : workers) w.join();
+            iterations_ += iterations;
+
+            CfrTrainingStats stats;
+            stats.iterations = iterations;
+            stats.nodes = nodes;
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats.iterationsPerSecond = stats.seconds > 0 ? iterations / stats.seconds : 0;
+            return stats;
+        }
+
+        // ƽԣϢۼһ
+        std::vector<float> averageStrategy() const {
+            std::vector<float> strategy(size_);
+            for (size_t info = 0; info < size_; info += ABSTRACT_ACTIONS) {
+                double sum = 0;
+                for (int a = 0; a < ABSTRACT_ACTIONS; ++a) sum += strategySum_[info + a].load(std::memory_order_relaxed);
+                if (sum <= 0) continue;
+                for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                    strategy[info + a] = static_cast<float>(strategySum_[info + a].load(std::memory_order_relaxed) / sum);
+                }
+            }
+            return strategy;
+        }
+
+        void write(const std::string& path) const {
+            std::vector<float> strategy = averageStrategy();
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(strategy.data());
+            size_t payload = strategy.size() * sizeof(float);
+
+            CfrFileHeader h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, CFR_MAGIC, sizeof(CFR_MAGIC));
+            h.version = CFR_VERSION;
+            h.actions = ABSTRACT_ACTIONS;
+            h.infosets = static_cast<uint32_t>(CfrAbstraction::infosetCount());
+            h.bettingStates = CfrAbstraction::BETTING_STATES;
+            h.preflopBuckets = CfrAbstraction::PREFLOP_BUCKETS;
+            h.postflopBuckets = CfrAbstraction::POSTFLOP_BUCKETS;
+            h.iterations = iterations_;
+            h.seed = options_.seed;
+            h.checksum = rules::fnv1a64(bytes, payload);
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot create " + path);
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            out.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(payload));
+            if (!out) throw std::runtime_error("Cannot write " + path);
+        }
+
+        uint64_t iterations() const { return iterations_; }
+
+        // ѵʱźֵͲۼռõڴ
+        size_t memoryBytes() const { return 2 * size_ * sizeof(std::atomic<float>); }
+
+    private:
+        // һƸλڸֵʱһ
+        struct Deal {
+            int bucket[2][4];
+        };
+
+        CfrTrainerOptions options_;
+        size_t size_;
+        std::unique_ptr<std::atomic<float>[]> regrets_;
+        std::unique_ptr<std::atomic<float>[]> strategySum_;
+        uint64_t iterations_ = 0;
+
+        void iterate(Xoshiro256& rng, uint64_t& visited) {
+            int32_t span = options_.maxStack - options_.minStack + 1;
+            int32_t stacks[2] = {
+                options_.minStack + static_cast<int32_t>(rng.bounded(static_cast<uint32_t>(span))),
+                options_.minStack + static_cast<int32_t>(rng.bounded(static_cast<uint32_t>(span)))
+            };
+            HandState s = GameEngine::startHand(options_.table, stacks, static_cast<int>(rng.bounded(2)), rng);
+
+            Deal deal;
+            CardSet holes[2] = { s.seat[0].hole, s.seat[1].hole };
+            for (int p = 0; p < 2; ++p) deal.bucket[p][0] = rules::StartingHands::classIndex(holes[p]);
+            CardSet board;
+            for (int street = 1; street < 4; ++street) {
+                for (int i = board.size(); i < street + 2; ++i) board.add(s.boardCard(i));
+                double strength[2];
+                CfrAbstraction::handStrength(holes, 2, board, strength);
+                for (int p = 0; p < 2; ++p) deal.bucket[p][street] = CfrAbstraction::strengthBucket(strength[p]);
+            }
+
+            for (int traverser = 0; traverser < 2; ++traverser) traverse(s, traverser, deal, rng, visited);
+        }
+
+        // źƥ䣺źֵıȫΪ0ʱںϷ
+        void currentStrategy(int info, unsigned mask, float* sigma) const {
+            float sum = 0;
+            int legal = 0;
+            for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                sigma[a] = (mask >> a) & 1 ? std::max(regrets_[info * ABSTRACT_ACTIONS + a].load(std::memory_order_relaxed), 0.0f) : 0.0f;
+                sum += sigma[a];
+                legal += (mask >> a) & 1;
+            }
+            for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                if (sum > 0) sigma[a] /= sum;
+                else sigma[a] = (mask >> a) & 1 ? 1.0f / legal : 0.0f;
+            }
+        }
+
+        // رڸýڵ棨äע
+        double traverse(const HandState& s, int traverser, const Deal& deal, Xoshiro256& rng, uint64_t& visited) {
+            if (s.finished()) {
+                return static_cast<double>(s.seat[traverser].won - s.seat[traverser].committed) / s.config.bigBlind;
+            }
+            visited++;
+            int player = s.toAct;
+            int street = static_cast<int>(s.street);
+            int info = CfrAbstraction::infoset(street, CfrAbstraction::bettingState(s), deal.bucket[player][street]);
+            unsigned mask = CfrAbstraction::legalMask(s);
+            float sigma[ABSTRACT_ACTIONS];
+            currentStrategy(info, mask, sigma);
+            std::atomic<float>* regret = &regrets_[info * ABSTRACT_ACTIONS];
+
+            if (player == traverser) {
+                double value[ABSTRACT_ACTIONS] = { 0 };
+                double node = 0;
+                for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                    if (!((mask >> a) & 1)) continue;
+                    HandState child = s;
+                    GameEngine::apply(child, CfrAbstraction::toAction(s, static_cast<AbstractAction>(a)));
+                    value[a] = traverse(child, traverser, deal, rng, visited);
+                    node += sigma[a] * value[a];
+                }
+                for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                    if (!((mask >> a) & 1)) continue;
+                    float r = regret[a].load(std::memory_order_relaxed) + static_cast<float>(value[a] - node);
+                    regret[a].store(std::max(r, 0.0f), std::memory_order_relaxed);
+                }
+                return node;
+            }
+
+            // ֽڵ㣺ۼƽԣǰԳһ
+            std::atomic<float>* sum = &strategySum_[info * ABSTRACT_ACTIONS];
+            double x = (rng() >> 11) * (1.0 / 9007199254740992.0);
+            int chosen = -1;
+            for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                if (!((mask >> a) & 1)) continue;
+                sum[a].store(sum[a].load(std::memory_order_relaxed) + sigma[a], std::memory_order_relaxed);
+                if (chosen < 0 && (x -= sigma[a]) < 0) chosen = a;
+            }
+            if (chosen < 0) chosen = highestLegal(mask);
+            HandState child = s;
+            GameEngine::apply(child, CfrAbstraction::toAction(s, static_cast<AbstractAction>(chosen)));
+            return traverse(child, traverser, deal, rng, visited);
+        }
+
+        static int highestLegal(unsigned mask) {
+            int a = ABSTRACT_ACTIONS - 1;
+            while (a > 0 && !((mask >> a) & 1)) a--;
+            return a;
+        }
+    };
+
+    // ʱԣӳļÿξһβ
+    class CfrStrategy {
+    public:
+        static CfrStrategy open(const std::string& path) {
+            CfrStrategy strategy;
+            strategy.file_.open(path);
+            if (strategy.file_.size() < sizeof(CfrFileHeader)) throw std::runtime_error("CFR strategy is truncated");
+            const CfrFileHeader* h = reinterpret_cast<const CfrFileHeader*>(strategy.file_.data());
+            if (std::memcmp(h->magic, CFR_MAGIC, sizeof(CFR_MAGIC)) != 0) {
+                throw std::runtime_error("Not a CFR strategy file");
+            }
+            if (h->version != CFR_VERSION) throw std::runtime_error("Unsupported CFR strategy version");
+            size_t payload = static_cast<size_t>(CfrAbstraction::infosetCount()) * ABSTRACT_ACTIONS * sizeof(float);
+            if (h->actions != ABSTRACT_ACTIONS || h->infosets != static_cast<uint32_t>(CfrAbstraction::infosetCount()) ||
+                h->bettingStates != CfrAbstraction::BETTING_STATES || h->preflopBuckets != CfrAbstraction::PREFLOP_BUCKETS ||
+                h->postflopBuckets != CfrAbstraction::POSTFLOP_BUCKETS || strategy.file_.size() != sizeof(CfrFileHeader) + payload) {
+                throw std::runtime_error("CFR strategy has an unexpected layout");
+            }
+            if (rules::fnv1a64(strategy.file_.data() + sizeof(CfrFileHeader), payload) != h->checksum) {
+                throw std::runtime_error("CFR strategy checksum mismatch");
+            }
+            strategy.header_ = h;
+            strategy.strategy_ = reinterpret_cast<const float*>(strategy.file_.data() + sizeof(CfrFileHeader));
+            return strategy;
+        }
+
+        const CfrFileHeader& header() const { return *header_; }
+
+        // Ϣĸ
+        const float* probabilities(int infoset) const { return strategy_ + infoset * ABSTRACT_ACTIONS; }
+
+        // ǰж߰ƽԳһδѵϢƻע
+        Action choose(const HandState& s, Xoshiro256& rng) const {
+            POKER_TIMED(CfrDecision, 1);
+            const engine::SeatState& me = s.seat[s.toAct];
+            int street = static_cast<int>(s.street);
+            int bucket = CfrAbstraction::bucket(me.hole, s.boardSet());
+            const float* p = probabilities(CfrAbstraction::infoset(street, CfrAbstraction::bettingState(s), bucket));
+            unsigned mask = CfrAbstraction::legalMask(s);
+
+            double total = 0;
+            for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                if ((mask >> a) & 1) total += p[a];
+            }
+            AbstractAction chosen = AbstractAction::Call;
+            if (total > 0) {
+                double x = (rng() >> 11) * (1.0 / 9007199254740992.0) * total;
+                for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                    if (!((mask >> a) & 1) || p[a] <= 0) continue;
+                    chosen = static_cast<AbstractAction>(a);
+                    if ((x -= p[a]) < 0) break;
+                }
+            }
+            return CfrAbstraction::toAction(s, chosen);
+        }
+
+    private:
+        MappedFile file_;
+        const CfrFileHeader* header_ = nullptr;
+        const float* strategy_ = nullptr;
+    };
+
+}
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef DECISION_H
+#define DECISION_H
+
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include "poker.h"
+#include "rng.h"
+#include "fast_evaluator.h"
+#include "outs.h"
+#include "game_engine.h"
+#include "cfr.h"
+
+namespace ai {
+
+    struct DecisionOptions {
+        double budgetUs = 5000;       // ÿξߵǽʱޣ΢룩
+        uint64_t maxSamples = 100000; // ˾ǰ
+        int batch = 32;               // ÿÿ֮һʱ
+    };
+
+    struct Decision {
+        Action action;
+        AbstractAction choice = AbstractAction::Call;
+        double equity = 0;                  // ԰עΪȨĶַΧʤ
+        int outs = 0;                       // ơתʱһ͵
+        double ev[ABSTRACT_ACTIONS] = { 0 }; // Ƶ棨룩ϷΪ 0
+        unsigned legal = 0;                 // Ϸλ
+        uint64_t samples = 0;
+        double elapsedUs = 0;
+        bool complete = false;              // ǰ maxSamples 
+    };
+
+    // ߺʱķֲʱ 2 ݷ飬ÿٷ 16 Լ 6%ٷλȡڵϽ
+    class LatencyStats {
+    public:
+        static const int SUB_BITS = 4;
+        static const int BUCKETS = 48 << SUB_BITS;
+
+        void record(const Decision& d, double budgetUs) {
+            count_++;
+            totalUs_ += d.elapsedUs;
+            maxUs_ = std::max(maxUs_, d.elapsedUs);
+            totalSamples_ += d.samples;
+            minSamples_ = count_ == 1 ? d.samples : std::min(minSamples_, d.samples);
+            if (d.elapsedUs > budgetUs) overBudget_++;
+            histogram_[bucketOf(d.elapsedUs)]++;
+        }
+
+        uint64_t count() const { return count_; }
+        uint64_t overBudget() const { return overBudget_; }
+        double meanUs() const { return count_ ? totalUs_ / count_ : 0; }
+        double maxUs() const { return maxUs_; }
+        double meanSamples() const { return count_ ? static_cast<double>(totalSamples_) / count_ : 0; }
+        uint64_t minSamples() const { return minSamples_; }
+
+        // q ȡ 0-1 0.99
+        double percentileUs(double q) const {
+            if (count_ == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(std::ceil(q * count_));
+            uint64_t seen = 0;
+            for (int b = 0; b < BUCKETS; ++b) {
+                seen += histogram_[b];
+                if (seen >= rank && seen > 0) return std::min(upperBound(b), maxUs_);
+            }
+            return maxUs_;
+        }
+
+        void reset() { *this = LatencyStats(); }
+
+    private:
+        uint64_t histogram_[BUCKETS] = { 0 };
+        uint64_t count_ = 0;
+        uint64_t overBudget_ = 0;
+        uint64_t totalSamples_ = 0;
+        uint64_t minSamples_ = 0;
+        double totalUs_ = 0;
+        double maxUs_ = 0;
+
+        //  1/16 ΢ΪλС 16 λֱӷֵ֮ÿ 2 ݷ 16 
+        static int bucketOf(double us) {
+            const uint64_t SUB = 1u << SUB_BITS;
+            uint64_t units = static_cast<uint64_t>(us * SUB);
+            if (units < SUB) return static_cast<int>(units);
+            int log = 63 - leadingZeros(units);
+            int sub = static_cast<int>((units >> (log - SUB_BITS)) & (SUB - 1));
+            return std::min(BUCKETS - 1, ((log - SUB_BITS + 1) << SUB_BITS) + sub);
+        }
+
+        static double upperBound(int bucket) {
+            const uint64_t SUB = 1u << SUB_BITS;
+            if (bucket < static_cast<int>(SUB)) return (bucket + 1) / static_cast<double>(SUB);
+            int log = (bucket >> SUB_BITS) + SUB_BITS - 1;
+            uint64_t sub = bucket & (SUB - 1);
+            return static_cast<double>((SUB + sub + 1) << (log - SUB_BITS)) / SUB;
+        }
+
+        static int leadingZeros(uint64_t x) {
+            int n = 0;
+            while (!(x & (1ULL << 63))) { x <<= 1; n++; }
+            return n;
+        }
+    };
+
+    // ʱʱߣ׼һϷĬ϶ٷֵƺʣ๫ƣ
+    // ޻˾ͰǰѡĶ
+    //
+    // ַΧѿעȨԵעԽ󡢱ּעԽ࣬ǿƵȨԽߡ
+    // עʰСƵʹƣֻ÷Χǿ pot/(pot+ע) ּ
+    class AnytimeDecider {
+    public:
+        explicit AnytimeDecider(const DecisionOptions& options = DecisionOptions()) : options_(options) {
+            // ״ʹʱɣǰһξ
+            rules::FastEvaluator::score(CardSet::fullDeck() - CardSet::fullDeck());
+        }
+
+        Decision decide(const HandState& s, Xoshiro256& rng) {
+            POKER_TIMED(AnytimeDecision, 1);
+            auto start = std::chrono::steady_clock::now();
+            auto deadline = start + std::chrono::nanoseconds(static_cast<int64_t>(options_.budgetUs * 1000));
+
+            Decision d;
+            d.legal = CfrAbstraction::legalMask(s);
+            d.choice = AbstractAction::Call;
+            if (d.legal & CfrAbstraction::bit(AbstractAction::Fold)) d.choice = AbstractAction::Fold;
+            d.action = CfrAbstraction::toAction(s, d.choice);
+
+            int hero = s.toAct;
+            CardSet hole = s.seat[hero].hole;
+            CardSet board = s.boardSet();
+            double pressure = aggression(s);
+            Tally tally;
+            if (board.size() == 3 || board.size() == 4) {
+                rules::OutsResult outs;
+                rules::Outs::compute(&hole, 1, board, outs);
+                d.outs = outs.players[0].count();
+            }
+
+            Deck deck(CardSet::fullDeck() - hole - board);
+            rules::FastEvaluator::Accumulator base;
+            for (CardSet rest = board; !rest.empty();) base.add(rest.popFirst());
+            int toDeal = 5 - board.size();
+            // һĺʱһܳ޾Ͳٿʼ
+            auto batchStart = std::chrono::steady_clock::now();
+            bool finished = false;
+            while (!finished) {
+                for (int i = 0; i < options_.batch; ++i) {
+                    deck.restore();
+                    CardSet opponent = deck.dealRandomSet(rng, 2);
+                    CardSet runout = deck.dealRandomSet(rng, toDeal);
+                    double strength = strengthProxy(opponent, board);
+                    double weight = std::exp(pressure * (strength - 0.5));
+
+                    rules::FastEvaluator::Accumulator mine = base, theirs = base;
+                    for (CardSet rest = hole | runout; !rest.empty();) mine.add(rest.popFirst());
+                    for (CardSet rest = opponent | runout; !rest.empty();) theirs.add(rest.popFirst());
+                    uint32_t a = rules::FastEvaluator::score(mine), b = rules::FastEvaluator::score(theirs);
+                    tally.add(strength, weight, a > b ? 1.0 : (a == b ? 0.5 : 0.0));
+                }
+                d.samples += options_.batch;
+                auto now = std::chrono::steady_clock::now();
+                finished = d.samples >= options_.maxSamples || now + 2 * (now - batchStart) >= deadline;
+                batchStart = now;
+            }
+            d.complete = d.samples >= options_.maxSamples;
+
+            choose(s, tally, d);
+            d.elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            stats_.record(d, options_.budgetUs);
+            return d;
+        }
+
+        const LatencyStats& stats() const { return stats_; }
+        LatencyStats& stats() { return stats_; }
+        const DecisionOptions& options() const { return options_; }
+        void setBudget(double budgetUs) { options_.budgetUs = budgetUs; }
+
+    private:
+        static const int STRENGTH_BINS = 20;
+
+        // ֵۼȨغʤʷݶʱǿĵȡ
+        struct Tally {
+            double weight[STRENGTH_BINS] = { 0 };
+            double share[STRENGTH_BINS] = { 0 };
+
+            void add(double strength, double w, double result) {
+                int bin = std::min(STRENGTH_BINS - 1, static_cast<int>(strength * STRENGTH_BINS));
+                weight[bin] += w;
+                share[bin] += w * result;
+            }
+
+            double equity() const {
+                double w = 0, s = 0;
+                for (int b = 0; b < STRENGTH_BINS; ++b) { w += weight[b]; s += share[b]; }
+                return w > 0 ? s / w : 0.5;
+            }
+
+            //  continueFraction ķΧʱʵʼıͶԼΧʤ
+            void facingRaise(double continueFraction, double& continued, double& equity) const {
+                double total = 0;
+                for (int b = 0; b < STRENGTH_BINS; ++b) total += weight[b];
+                double need = continueFraction * total, w = 0, s = 0;
+                for (int b = STRENGTH_BINS - 1; b >= 0 && w < need; --b) {
+                    double take = std::min(weight[b], need - w);
+                    if (weight[b] > 0) s += share[b] * take / weight[b];
+                    w += take;
+                }
+                continued = total > 0 ? w / total : 1.0;
+                equity = w > 0 ? s / w : 0.5;
+            }
+        };
+
+        DecisionOptions options_;
+        LatencyStats stats_;
+
+        // ֱֳĹԣԵעռ׳صıϱּע
+        static double aggression(const HandState& s) {
+            const engine::SeatState& me = s.seat[s.toAct];
+            double toCall = s.currentBet - me.bet;
+            double pot = std::max(s.pot(), 1);
+            return 6.0 * toCall / pot + std::min<int>(s.raises, 3);
+        }
+
+        // ֵѹϵĴǿȣ0-1ֻڼȨҪȷ
+        static double strengthProxy(CardSet hole, CardSet board) {
+            CardSet h = hole;
+            Card a = h.popFirst(), b = h.popFirst();
+            int hi = std::max(rankIndex(a.rank()), rankIndex(b.rank()));
+            int lo = std::min(rankIndex(a.rank()), rankIndex(b.rank()));
+            if (board.empty()) {
+                if (hi == lo) return 0.5 + 0.5 * hi / 12.0;
+                double v = 0.4 * (hi + lo) / 23.0;
+                if (a.suit() == b.suit()) v += 0.05;
+                if (hi - lo == 1) v += 0.05;
+                return v;
+            }
+            int category = static_cast<int>(rules::HandStrength(rules::FastEvaluator::score(hole | board)).rank());
+            return std::min(category, 8) / 8.0 * 0.85 + 0.15 * hi / 12.0;
+        }
+
+        // ɹֵ棨ƣλ룩ѡ
+        static void choose(const HandState& s, const Tally& tally, Decision& d) {
+            if (d.samples == 0) return;
+            const engine::SeatState& me = s.seat[s.toAct];
+            engine::LegalActions legal = GameEngine::legalActions(s);
+            int32_t oppBet = 0, oppStack = 0;
+            for (int i = 0; i < s.config.seats; ++i) {
+                if (i == s.toAct || !s.seat[i].inHand) continue;
+                oppBet = std::max(oppBet, s.seat[i].bet);
+                oppStack = std::max(oppStack, s.seat[i].stack);
+            }
+
+            d.equity = tally.equity();
+            double pot = s.pot();
+            double best = -1e300;
+            for (int a = 0; a < ABSTRACT_ACTIONS; ++a) {
+                if (!((d.legal >> a) & 1)) continue;
+                AbstractAction action = static_cast<AbstractAction>(a);
+                double ev = 0;
+                if (action == AbstractAction::Call) {
+                    ev = d.equity * (pot + legal.callAmount) - legal.callAmount;
+                }
+                else if (action != AbstractAction::Fold) {
+                    int32_t target = action == AbstractAction::AllIn ? legal.maxRaiseTo
+                        : CfrAbstraction::raiseAmount(s, legal, action == AbstractAction::RaiseHalf ? 0.5 : 1.0);
+                    target = std::min(target, oppBet + oppStack);   // ָĲֻ˻
+                    double extra = target - me.bet;
+                    double oppCall = target - oppBet;
+                    double continued, equity;
+                    tally.facingRaise(pot / (pot + oppCall), continued, equity);
+                    ev = (1 - continued) * pot + continued * (equity * (pot + extra + oppCall) - extra);
+                }
+                d.ev[a] = ev;
+                if (ev > best) {
+                    best = ev;
+                    d.choice = action;
+                }
+            }
+            d.action = CfrAbstraction::toAction(s, d.choice);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef EASYX_RENDERER_H
+#define EASYX_RENDERER_H
+
+#include <string>
+#include <vector>
+#include "ks.h"
+#include "poker.h"
+#include "renderer.h"
+
+namespace render {
+
+    // EasyX ˣ52Ʊʱ롢һηŽͼ
+    // ʱֻͼͱͼҪ򣬲ֻˢ
+    class EasyXRenderer : public Renderer {
+    public:
+        EasyXRenderer(int width, int height, LPCTSTR backgroundPath)
+            : width_(width), height_(height),
+              atlas_(AtlasLayout::COLUMNS * CARD_WIDTH, AtlasLayout::ROWS * CARD_HEIGHT) {
+            initgraph(width, height);
+            BeginBatchDraw();
+            setbkmode(TRANSPARENT);
+            loadimage(&background_, backgroundPath, width, height);
+            loadAtlas();
+        }
+
+        ~EasyXRenderer() override {
+            setcliprgn(NULL);
+            EndBatchDraw();
+            closegraph();
+        }
+
+        int width() const override { return width_; }
+        int height() const override { return height_; }
+
+        void setClip(const Rect& clip) override {
+            clip_ = clip;
+            HRGN region = CreateRectRgn(clip.left, clip.top, clip.right, clip.bottom);
+            setcliprgn(region);
+            DeleteObject(region);
+        }
+
+        void drawBackground() override {
+            putimage(clip_.left, clip_.top, clip_.width(), clip_.height(), &background_, clip_.left, clip_.top);
+        }
+
+        void drawSprite(int slot, int x, int y) override {
+            Rect source = AtlasLayout::slotRect(slot, CARD_WIDTH, CARD_HEIGHT);
+            putimage(x, y, CARD_WIDTH, CARD_HEIGHT, &atlas_, source.left, source.top);
+        }
+
+        void fillRoundRect(const Rect& rect, Color color) override {
+            setfillcolor(color);
+            fillroundrect(rect.left, rect.top, rect.right, rect.bottom, 10, 10);
+        }
+
+        void drawText(int x, int y, const std::wstring& text, Color color) override {
+            settextcolor(color);
+#ifdef UNICODE
+            outtextxy(x, y, text.c_str());
+#else
+            int size = WideCharToMultiByte(CP_ACP, 0, text.c_str(), -1, NULL, 0, NULL, NULL);
+            std::string local(size, '\0');
+            WideCharToMultiByte(CP_ACP, 0, text.c_str(), -1, &local[0], size, NULL, NULL);
+            outtextxy(x, y, local.c_str());
+#endif
+        }
+
+        void present(const std::vector<Rect>& dirty) override {
+            for (const Rect& r : dirty) FlushBatchDraw(r.left, r.top, r.right - 1, r.bottom - 1);
+        }
+
+    private:
+        int width_, height_;
+        IMAGE background_;
+        IMAGE atlas_;
+        Rect clip_;
+
+        // ÿͼƬֻӴ̶ȡһ
+        void loadAtlas() {
+            SetWorkingImage(&atlas_);
+            for (int s = 0; s < 4; ++s) {
+                for (int r = 1; r <= 13; ++r) {
+                    Poker::Card card(static_cast<Poker::Suit>(s), static_cast<Poker::Rank>(r));
+                    loadSlot(card.index(), getCardImageName(card));
+                }
+            }
+            loadSlot(AtlasLayout::CARD_BACK, CARD_BACK_IMAGE);
+            SetWorkingImage();
+        }
+
+        void loadSlot(int slot, LPCTSTR name) {
+            TCHAR imgPath[MAX_PATH] = { 0 };
+            _stprintf_s(imgPath, _T("%s%s"), CARD_IMAGE_BASE_PATH, name);
+
+            Rect target = AtlasLayout::slotRect(slot, CARD_WIDTH, CARD_HEIGHT);
+            IMAGE cardImg;
+            loadimage(&cardImg, imgPath, CARD_WIDTH, CARD_HEIGHT);
+            if (cardImg.getwidth() > 0) {
+                putimage(target.left, target.top, &cardImg);
+            }
+            else {
+                drawErrorCard(target.left, target.top, _T("Load Failed"));
+            }
+        }
+
+        // Ƭƺ
+        static void drawErrorCard(int x, int y, LPCTSTR msg) {
+            setfillcolor(HSVtoRGB(0, 0.8f, 1)); // ɫ
+            fillrectangle(x, y, x + CARD_WIDTH, y + CARD_HEIGHT);
+
+            settextcolor(BLACK);
+            settextstyle(14, 0, _T("Consolas"));
+            outtextxy(x + 5, y + 5, msg);
+        }
+
+        // תΪͼƬļ
+        static LPCTSTR getCardImageName(const Poker::Card& card) {
+            static TCHAR filename[50];
+
+            const TCHAR* suitStr;
+            switch (card.suit()) {
+            case Poker::Suit::Hearts:   suitStr = _T("heart");   break;
+            case Poker::Suit::Diamonds: suitStr = _T("diamond"); break;
+            case Poker::Suit::Clubs:    suitStr = _T("club");    break;
+            case Poker::Suit::Spades:   suitStr = _T("spade");   break;
+            default:                    suitStr = _T("unknown");
+            }
+
+            const TCHAR* rankStr;
+            switch (card.rank()) {
+            case Poker::Rank::Ace:   rankStr = _T("A");  break;
+            case Poker::Rank::Two:   rankStr = _T("2");  break;
+            case Poker::Rank::Three: rankStr = _T("3");  break;
+            case Poker::Rank::Four:  rankStr = _T("4");  break;
+            case Poker::Rank::Five:  rankStr = _T("5");  break;
+            case Poker::Rank::Six:   rankStr = _T("6");  break;
+            case Poker::Rank::Seven: rankStr = _T("7");  break;
+            case Poker::Rank::Eight: rankStr = _T("8");  break;
+            case Poker::Rank::Nine:  rankStr = _T("9");  break;
+            case Poker::Rank::Ten:   rankStr = _T("10"); break;
+            case Poker::Rank::Jack:  rankStr = _T("J");  break;
+            case Poker::Rank::Queen: rankStr = _T("Q");  break;
+            case Poker::Rank::King:  rankStr = _T("K");  break;
+            default:                 rankStr = _T("?");
+            }
+
+            _stprintf_s(filename, _T("%s%s.png"), suitStr, rankStr);
+            return filename;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef EQUITY_H
+#define EQUITY_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "fast_evaluator.h"
+
+namespace rules {
+
+    // ؿʤʼֵֹͣΪ0ʾʹøҪһ
+    struct EquityOptions {
+        uint64_t maxTrials = 100000;    // ģ
+        double timeBudgetMs = 0;        // ʱԤ㣨룩
+        double targetStdError = 0;      // ʤʵı׼󶼲ֵʱֹͣ
+        unsigned threads = 0;           // ߳0 ʾʹȫ
+        uint64_t seed = 0;              // ӣ0 ʾ random_device ɣֹͣʱɸ
+    };
+
+    // ҵĽequity = win + ƽֵ׳ʱֵķݶ
+    struct PlayerEquity {
+        double win = 0;
+        double tie = 0;
+        double lose = 0;
+        double equity = 0;
+        double stdError = 0;
+        double ciLow = 0;     // 95% 
+        double ciHigh = 0;
+    };
+
+    struct EquityResult {
+        std::vector<PlayerEquity> players;  // ֪Ƶңδ֪
+        uint64_t trials = 0;
+        double elapsedMs = 0;
+    };
+
+    // ߳ؿʤ棺ģⰴȡÿʹӺžĶ
+    // ÿ߳ԼƶѺۼʱϲ
+    class MonteCarloEquity {
+    public:
+        static EquityResult run(
+            const std::vector<HoleCards>& knownHands,
+            const std::vector<Card>& communityCards,
+            int unknownOpponents,
+            const EquityOptions& options = EquityOptions()
+        ) {
+            auto start = std::chrono::steady_clock::now();
+            Setup setup = prepare(knownHands, communityCards, unknownOpponents, options);
+
+            unsigned threadCount = options.threads ? options.threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+
+            uint64_t seed = options.seed ? options.seed : randomSeed();
+
+            Shared shared;
+            shared.options = options;
+            std::vector<Accumulator> published(threadCount, Accumulator(setup.players));
+            std::vector<std::mutex> locks(threadCount);
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    Accumulator batch(setup.players);
+                    while (!shared.stop.load(std::memory_order_relaxed)) {
+                        uint64_t index = 0;
+                        uint64_t n = shared.reserve(index);
+                        if (n == 0) break;
+                        // ÿͬԼʼ̵߳޹
+                        Deck deck(setup.live);
+                        Xoshiro256 rng(seed, index);
+                        for (uint64_t i = 0; i < n; ++i) simulate(setup, deck, rng, batch);
+                        std::lock_guard<std::mutex> guard(locks[t]);
+                        published[t].merge(batch);
+                        batch.clear();
+                    }
+                });
+            }
+
+            // ̸߳ʱԤͱ׼
+            if (options.timeBudgetMs > 0 || options.targetStdError > 0) {
+                while (!shared.stop.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    if (options.timeBudgetMs > 0 && elapsedMs(start) >= options.timeBudgetMs) break;
+                    if (options.targetStdError > 0) {
+                        Accumulator total = mergeAll(published, locks, setup.players);
+                        if (total.trials >= MIN_TRIALS_FOR_ERROR &&
+                            total.maxStdError() <= options.targetStdError) break;
+                    }
+                    if (shared.exhausted()) break;
+                }
+                shared.stop = true;
+            }
+            for (auto& w : workers) w.join();
+
+            Accumulator total = mergeAll(published, locks, setup.players);
+            EquityResult result = total.toResult();
+            result.elapsedMs = elapsedMs(start);
+            return result;
+        }
+
+    private:
+        static const uint64_t BATCH = 1024;
+        static const int MAX_PLAYERS = 26;  // 52๻26
+        static const uint64_t MIN_TRIALS_FOR_ERROR = 1000;
+
+        struct Setup {
+            std::vector<CardSet> known;   // ֪
+            CardSet board;
+            int unknown = 0;
+            int players = 0;
+            int boardToDeal = 0;
+            CardSet live;                 // ɷ
+        };
+
+        // ÿҵۼʤƽݶݶƽڱ׼
+        struct Accumulator {
+            uint64_t trials = 0;
+            std::vector<uint64_t> wins, ties;
+            std::vector<double> share, shareSq;
+
+            explicit Accumulator(int players)
+                : wins(players), ties(players), share(players), shareSq(players) {}
+
+            void merge(const Accumulator& other) {
+                trials += other.trials;
+                for (size_t i = 0; i < wins.size(); ++i) {
+                    wins[i] += other.wins[i];
+                    ties[i] += other.ties[i];
+                    share[i] += other.share[i];
+                    shareSq[i] += other.shareSq[i];
+                }
+            }
+
+            void clear() {
+                trials = 0;
+                std::fill(wins.begin(), wins.end(), 0);
+                std::fill(ties.begin(), ties.end(), 0);
+                std::fill(share.begin(), share.end(), 0.0);
+                std::fill(shareSq.begin(), shareSq.end(), 0.0);
+            }
+
+            double stdError(size_t i) const {
+                if (trials < 2) return 1.0;
+                double n = static_cast<double>(trials);
+                double mean = share[i] / n;
+                double var = (shareSq[i] / n - mean * mean) * n / (n - 1);
+                return std::sqrt(std::max(var, 0.0) / n);
+            }
+
+            double maxStdError() const {
+                double worst = 0;
+                for (size_t i = 0; i < wins.size(); ++i) worst = std::max(worst, stdError(i));
+                return worst;
+            }
+
+            EquityResult toResult() const {
+                EquityResult result;
+                result.trials = trials;
+                double n = trials ? static_cast<double>(trials) : 1.0;
+                for (size_t i = 0; i < wins.size(); ++i) {
+                    PlayerEquity p;
+                    p.win = wins[i] / n;
+                    p.tie = ties[i] / n;
+                    p.lose = trials ? 1.0 - p.win - p.tie : 0.0;
+                    p.equity = share[i] / n;
+                    p.stdError = stdError(i);
+                    p.ciLow = std::max(0.0, p.equity - 1.96 * p.stdError);
+                    p.ciHigh = std::min(1.0, p.equity + 1.96 * p.stdError);
+                    result.players.push_back(p);
+                }
+                return result;
+            }
+        };
+
+        // ̼߳乲ֹͣ״̬
+        struct Shared {
+            EquityOptions options;
+            std::atomic<uint64_t> batches{ 0 };
+            std::atomic<bool> stop{ false };
+
+            // ȡһģ⣬ر0 ʾѴޣ
+            uint64_t reserve(uint64_t& index) {
+                index = batches.fetch_add(1);
+                if (options.maxTrials == 0) return BATCH;
+                uint64_t begin = index * BATCH;
+                if (begin >= options.maxTrials) return 0;
+                uint64_t left = options.maxTrials - begin;
+                return left < BATCH ? left : BATCH;
+            }
+
+            bool exhausted() const {
+                return options.maxTrials != 0 && batches.load() * BATCH >= options.maxTrials;
+            }
+        };
+
+        static Setup prepare(const std::vector<HoleCards>& knownHands,
+            const std::vector<Card>& communityCards, int unknownOpponents,
+            const EquityOptions& options) {
+            if (options.maxTrials == 0 && options.timeBudgetMs <= 0 && options.targetStdError <= 0) {
+                throw std::invalid_argument("No stopping condition for equity simulation");
+            }
+            if (communityCards.size() > 5 || unknownOpponents < 0) {
+                throw std::invalid_argument("Invalid board or opponent count");
+            }
+
+            Setup setup;
+            CardSet dead;
+            for (const auto& hand : knownHands) {
+                if (!hand.hasCards()) throw std::invalid_argument("Known hand has no cards");
+                CardSet cards = hand.getCardSet();
+                if ((dead & cards).size() != 0 || cards.size() != 2) {
+                    throw std::invalid_argument("Duplicate card in known hands");
+                }
+                dead |= cards;
+                setup.known.push_back(cards);
+            }
+            setup.board = CardSet::of(communityCards);
+            if ((dead & setup.board).size() != 0 || setup.board.size() != static_cast<int>(communityCards.size())) {
+                throw std::invalid_argument("Duplicate card on board");
+            }
+            dead |= setup.board;
+
+            setup.unknown = unknownOpponents;
+            setup.players = static_cast<int>(knownHands.size()) + unknownOpponents;
+            if (setup.players < 2) throw std::invalid_argument("Need at least two players");
+            setup.boardToDeal = 5 - static_cast<int>(communityCards.size());
+            setup.live = CardSet::fullDeck() - dead;
+            if (setup.live.size() < setup.boardToDeal + 2 * unknownOpponents) {
+                throw std::invalid_argument("Not enough cards for all players");
+            }
+            return setup;
+        }
+
+        // һģ⣺ջϴηƣֻҪ
+        static void simulate(const Setup& setup, Deck& deck, Xoshiro256& rng, Accumulator& acc) {
+            deck.restore();
+            CardSet board = setup.board | deck.dealRandomSet(rng, setup.boardToDeal);
+
+            uint32_t scores[MAX_PLAYERS];
+            int players = setup.players;
+            for (int p = 0; p < players; ++p) {
+                CardSet hand;
+                if (p < static_cast<int>(setup.known.size())) {
+                    hand = setup.known[p];
+                }
+                else {
+                    hand = deck.dealRandomSet(rng, 2);
+                }
+                scores[p] = FastEvaluator::score(hand | board);
+            }
+
+            uint32_t best = 0;
+            int winners = 0;
+            for (int p = 0; p < players; ++p) {
+                if (scores[p] > best) { best = scores[p]; winners = 1; }
+                else if (scores[p] == best) winners++;
+            }
+            double share = 1.0 / winners;
+            for (int p = 0; p < players; ++p) {
+                if (scores[p] != best) continue;
+                if (winners == 1) acc.wins[p]++;
+                else acc.ties[p]++;
+                acc.share[p] += share;
+                acc.shareSq[p] += share * share;
+            }
+            acc.trials++;
+        }
+
+        static Accumulator mergeAll(std::vector<Accumulator>& published,
+            std::vector<std::mutex>& locks, int players) {
+            Accumulator total(players);
+            for (size_t t = 0; t < published.size(); ++t) {
+                std::lock_guard<std::mutex> guard(locks[t]);
+                total.merge(published[t]);
+            }
+            return total;
+        }
+
+        static double elapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef EQUITY_CACHE_H
+#define EQUITY_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include "poker.h"
+#include "HoleCards.h"
+#include "equity.h"
+#include "suit_isomorphism.h"
+
+namespace rules {
+
+    struct CachedEquity {
+        float equity = 0;
+        float win = 0;
+        float tie = 0;
+        float stdError = 0;
+        uint32_t trials = 0;
+
+        // Ƿβѯﵽޣ׼ѴﵽĿ
+        bool precise(const EquityOptions& options) const {
+            if (trials >= options.maxTrials) return true;
+            return options.targetStdError > 0 && trials > 0 && stdError <= options.targetStdError;
+        }
+    };
+
+    struct EquityCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+        size_t memoryBytes = 0;   //  entryBytes() ռ
+
+        double hitRate() const {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
+    // ʤʻ棺Իɫ淶ľͶΪͬĲѯֻģһΡ
+    // ĽȲβѯҪ󣨴 maxTrials ұ׼δ꣩ʱδдģ⡣
+    // ֳɷƬÿƬһһ LRU ʱ̭δõ
+    // ڴԤ㻻õ
+    class EquityCache {
+    public:
+        static const size_t DEFAULT_BUDGET = 16 << 20;
+
+        explicit EquityCache(size_t memoryBudget = DEFAULT_BUDGET) {
+            size_t total = std::max<size_t>(SHARDS, memoryBudget / entryBytes());
+            for (auto& shard : shards_) {
+                shard.reset(new Shard);
+                shard->capacity = total / SHARDS;
+                shard->index.reserve(shard->capacity);
+            }
+        }
+
+        EquityCache(const EquityCache&) = delete;
+        EquityCache& operator=(const EquityCache&) = delete;
+
+        // ʱȡѸƵͷ
+        bool lookup(uint64_t state, int opponents, CachedEquity& out) {
+            bool found = find(state, opponents, out);
+            (found ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+            return found;
+        }
+
+        void store(uint64_t state, int opponents, const CachedEquity& value) {
+            Key key{ state, static_cast<uint32_t>(opponents) };
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> guard(shard.lock);
+            auto it = shard.index.find(key);
+            if (it != shard.index.end()) {
+                it->second->value = value;
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                return;
+            }
+            if (shard.lru.size() >= shard.capacity) {
+                shard.index.erase(shard.lru.back().key);
+                shard.lru.pop_back();
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+            }
+            shard.lru.push_front({ key, value });
+            shard.index[key] = shard.lru.begin();
+        }
+
+        //  opponents ֵʤʣδʱԹ淶Ĵؿģ⡣
+        // ߳ͬʱδͬһʱһΣе½ʱе
+        CachedEquity equity(CardSet hero, CardSet board, int opponents,
+            const EquityOptions& options = EquityOptions()) {
+            uint64_t state = SuitIsomorphism::index(hero, board);
+            CachedEquity cached;
+            bool found = find(state, opponents, cached);
+            if (found && cached.precise(options)) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return cached;
+            }
+            misses_.fetch_add(1, std::memory_order_relaxed);
+
+            CardSet hole, canonicalBoard;
+            SuitIsomorphism::unindex(state, hole, canonicalBoard);
+            HoleCards canonicalHero;
+            canonicalHero.receiveCards(hole);
+            EquityResult r = MonteCarloEquity::run({ canonicalHero }, canonicalBoard.toCards(), opponents, options);
+            CachedEquity result;
+            result.equity = static_cast<float>(r.players[0].equity);
+            result.win = static_cast<float>(r.players[0].win);
+            result.tie = static_cast<float>(r.players[0].tie);
+            result.stdError = static_cast<float>(r.players[0].stdError);
+            result.trials = static_cast<uint32_t>(r.trials);
+            if (found && cached.trials >= result.trials) return cached;
+            store(state, opponents, result);
+            return result;
+        }
+
+        CachedEquity equity(const HoleCards& hero, const std::vector<Card>& board, int opponents,
+            const EquityOptions& options = EquityOptions()) {
+            return equity(hero.getCardSet(), CardSet::of(board), opponents, options);
+        }
+
+        EquityCacheStats stats() const {
+            EquityCacheStats s;
+            s.hits = hits_.load(std::memory_order_relaxed);
+            s.misses = misses_.load(std::memory_order_relaxed);
+            s.evictions = evictions_.load(std::memory_order_relaxed);
+            for (const auto& shard : shards_) {
+                std::lock_guard<std::mutex> guard(shard->lock);
+                s.entries += shard->lru.size();
+                s.capacity += shard->capacity;
+            }
+            s.memoryBytes = s.entries * entryBytes();
+            return s;
+        }
+
+        void clear() {
+            for (auto& shard : shards_) {
+                std::lock_guard<std::mutex> guard(shard->lock);
+                shard->lru.clear();
+                shard->index.clear();
+            }
+            hits_ = 0;
+            misses_ = 0;
+            evictions_ = 0;
+        }
+
+        // ÿĴڴ棺ڵ㣨ָ룩ӹϣڵ㣨ָ롢ĹϣֵһͰ
+        static size_t entryBytes() {
+            return sizeof(Entry) + 2 * sizeof(void*) +
+                sizeof(std::pair<const Key, std::list<Entry>::iterator>) + 2 * sizeof(void*) + sizeof(void*);
+        }
+
+    private:
+        static const int SHARDS = 16;
+
+        struct Key {
+            uint64_t state;
+            uint32_t opponents;
+            bool operator==(const Key& o) const { return state == o.state && opponents == o.opponents; }
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& k) const {
+                uint64_t h = (k.state ^ k.opponents * 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+                return static_cast<size_t>(h ^ h >> 31);
+            }
+        };
+
+        struct Entry {
+            Key key;
+            CachedEquity value;
+        };
+
+        struct Shard {
+            mutable std::mutex lock;
+            std::list<Entry> lru;   // ͷΪʹ
+            std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+            size_t capacity = 0;
+        };
+
+        std::unique_ptr<Shard> shards_[SHARDS];
+        std::atomic<uint64_t> hits_{ 0 }, misses_{ 0 }, evictions_{ 0 };
+
+        // ҲƵͷͳ
+        bool find(uint64_t state, int opponents, CachedEquity& out) {
+            Key key{ state, static_cast<uint32_t>(opponents) };
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> guard(shard.lock);
+            auto it = shard.index.find(key);
+            if (it == shard.index.end()) return false;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            out = it->second->value;
+            return true;
+        }
+
+        Shard& shardFor(const Key& key) {
+            return *shards_[(KeyHash()(key) >> 7) % SHARDS];
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <functional>
+#include <vector>
+#include "poker.h"
+#include "texas_holdem_evaluator.h"
+
+namespace rules {
+
+    struct EvaluationCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;   // д
+        size_t capacity = 0;      // 
+        size_t memoryBytes = 0;
+
+        double hitRate() const {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
+    //  Evaluator::evaluateHand ǰ棬ͬһֻڵһΣ򱻸Ǻ
+    //
+    // ̶СĿѰַΪ 52 λ룬ڴԤ2 ݣÿ 4 Ϊһ飬
+    // ռһУֻһ飻ʱһιϣһۡ
+    //
+    // дÿ۴һţ˳дʱȰŸĳдټһ
+    // ǰͬΪżĲۣ߳дĲ۰δд
+    // ¾ƴɴĽ߳ͬʱдͬһʱ󵽵ķд롣ͳư̷߳ɢ
+    class EvaluationCache {
+    public:
+        static const size_t DEFAULT_BUDGET = 8 << 20;
+        static const int WAYS = 4;
+
+        explicit EvaluationCache(size_t memoryBudget = DEFAULT_BUDGET) {
+            size_t slots = WAYS;
+            while (slots * 2 * sizeof(Slot) <= memoryBudget) slots *= 2;
+            bits_ = 0;
+            while ((size_t(1) << bits_) < slots / WAYS) bits_++;
+            capacity_ = slots;
+            // new Slot[] ֻ֤ 8/16 ֽڶ룬һٰȡ 64 ֽ
+            storage_.reset(new char[slots * sizeof(Slot) + CACHE_LINE - 1]);
+            uintptr_t start = reinterpret_cast<uintptr_t>(storage_.get());
+            slots_ = reinterpret_cast<Slot*>((start + CACHE_LINE - 1) & ~static_cast<uintptr_t>(CACHE_LINE - 1));
+            for (size_t i = 0; i < slots; ++i) {
+                new (&slots_[i]) Slot;
+                slots_[i].seq.store(0, std::memory_order_relaxed);
+                slots_[i].score.store(0, std::memory_order_relaxed);
+                slots_[i].key.store(0, std::memory_order_relaxed);
+            }
+            clear();
+        }
+
+        EvaluationCache(const EvaluationCache&) = delete;
+        EvaluationCache& operator=(const EvaluationCache&) = delete;
+
+        bool lookup(CardSet cards, uint32_t& score) const {
+            uint64_t key = compact(cards) | VALID;
+            const Slot* group = &slots_[groupOf(key)];
+            for (int w = 0; w < WAYS; ++w) {
+                uint64_t k;
+                uint32_t value;
+                if (read(group[w], k, value) && k == key) {
+                    score = value;
+                    stripe().hits.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            stripe().misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        void store(CardSet cards, uint32_t score) {
+            uint64_t key = compact(cards) | VALID;
+            Slot* group = &slots_[groupOf(key)];
+            Slot* target = nullptr;
+            for (int w = 0; w < WAYS && !target; ++w) {
+                uint64_t k = group[w].key.load(std::memory_order_relaxed);
+                if (!(k & VALID) || k == key) target = &group[w];
+            }
+            if (!target) {
+                target = &group[(key * 0xD6E8FEB86659FD93ULL) >> 62];
+                stripe().evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            uint32_t seq = target->seq.load(std::memory_order_relaxed);
+            if ((seq & 1) || !target->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) return;
+            std::atomic_thread_fence(std::memory_order_release);
+            target->key.store(key, std::memory_order_relaxed);
+            target->score.store(score, std::memory_order_relaxed);
+            target->seq.store(seq + 2, std::memory_order_release);
+        }
+
+        // ʱֱӷأ evaluate д
+        template <class Evaluate>
+        uint32_t score(CardSet cards, Evaluate evaluate) {
+            uint32_t s;
+            if (lookup(cards, s)) return s;
+            s = evaluate(cards);
+            store(cards, s);
+            return s;
+        }
+
+        //  Evaluator::evaluateHand ӿͬ
+        HandStrength evaluateHand(CardSet cards) {
+            return HandStrength(score(cards, [](CardSet c) { return Evaluator::evaluateHand(c).value(); }));
+        }
+
+        HandStrength evaluateHand(const std::vector<Card>& cards) {
+            return evaluateHand(CardSet::of(cards));
+        }
+
+        EvaluationCacheStats stats() const {
+            EvaluationCacheStats s;
+            for (int i = 0; i < STRIPES; ++i) {
+                s.hits += stripes_[i].hits.load(std::memory_order_relaxed);
+                s.misses += stripes_[i].misses.load(std::memory_order_relaxed);
+                s.evictions += stripes_[i].evictions.load(std::memory_order_relaxed);
+            }
+            s.capacity = capacity_;
+            s.memoryBytes = capacity_ * sizeof(Slot);
+            return s;
+        }
+
+        // ձͳƣ̵߳ĶдͬʱʱȻȷĽ
+        void clear() {
+            for (size_t i = 0; i < capacity_; ++i) {
+                Slot& slot = slots_[i];
+                uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+                if ((seq & 1) || !slot.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) continue;
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.key.store(0, std::memory_order_relaxed);
+                slot.seq.store(seq + 2, std::memory_order_release);
+            }
+            for (auto& s : stripes_) {
+                s.hits = 0;
+                s.misses = 0;
+                s.evictions = 0;
+            }
+        }
+
+    private:
+        static const uint64_t VALID = 1ULL << 63;
+        static const int STRIPES = 64;
+        static const size_t CACHE_LINE = 64;
+
+        struct Slot {
+            std::atomic<uint32_t> seq;     // żΪΪд
+            std::atomic<uint32_t> score;
+            std::atomic<uint64_t> key;     // VALID | ѹ룬0 Ϊղ
+        };
+        static_assert(sizeof(Slot) * WAYS == CACHE_LINE, "A group of slots must fill one cache line");
+
+        // һ̵߳ļ뵽һ
+        struct Stripe {
+            std::atomic<uint64_t> hits{ 0 }, misses{ 0 }, evictions{ 0 };
+            char pad[64 - 3 * sizeof(std::atomic<uint64_t>)];
+        };
+
+        std::unique_ptr<char[]> storage_;   // ۵ԭʼڴ棬δ
+        Slot* slots_ = nullptr;             // storage_ аж
+        size_t capacity_ = 0;
+        int bits_ = 0;
+        mutable Stripe stripes_[STRIPES];
+
+        Stripe& stripe() const {
+            static thread_local size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % STRIPES;
+            return stripes_[index];
+        }
+
+        // ˳ǰһҲдŷ true
+        static bool read(const Slot& slot, uint64_t& key, uint32_t& score) {
+            uint32_t before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1) return false;
+            key = slot.key.load(std::memory_order_relaxed);
+            score = slot.score.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.seq.load(std::memory_order_relaxed) == before;
+        }
+
+        size_t groupOf(uint64_t key) const {
+            if (bits_ == 0) return 0;
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits_)) * WAYS;
+        }
+
+        // ÿֻɫ 16 λѹ 13 λ
+        static uint64_t compact(CardSet cards) {
+            uint64_t key = 0;
+            for (int s = 0; s < 4; ++s) key |= static_cast<uint64_t>(cards.suitMask(s)) << (13 * s);
+            return key;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef EXACT_EQUITY_H
+#define EXACT_EQUITY_H
+
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "fast_evaluator.h"
+#include "equity.h"
+
+namespace rules {
+
+    struct ExactEquityResult {
+        std::vector<PlayerEquity> players;                              // ȷֵstdError Ϊ0
+        std::vector<std::array<uint64_t, HAND_RANK_COUNT>> rankCounts;  // ÿλճɸ͵Ĵ
+        uint64_t runouts = 0;
+    };
+
+    // /תƺ֪ҵʱöʣ෢ƾȷʤ
+    // Ƽֻ֪ͳһΣÿַֻϵתƺͺ
+    class ExactEquity {
+    public:
+        static ExactEquityResult run(
+            const std::vector<HoleCards>& hands,
+            const std::vector<Card>& communityCards,
+            unsigned threads = 0
+        ) {
+            if (hands.size() < 2 || hands.size() > MAX_PLAYERS) {
+                throw std::invalid_argument("Exact equity needs 2 to 10 known hands");
+            }
+            if (communityCards.size() < 3 || communityCards.size() > 5) {
+                throw std::invalid_argument("Exact equity needs a flop, turn or river board");
+            }
+
+            Setup setup;
+            CardSet dead = CardSet::of(communityCards);
+            if (dead.size() != static_cast<int>(communityCards.size())) {
+                throw std::invalid_argument("Duplicate card on board");
+            }
+            setup.players = static_cast<int>(hands.size());
+            for (int p = 0; p < setup.players; ++p) {
+                if (!hands[p].hasCards()) throw std::invalid_argument("Known hand has no cards");
+                CardSet cards = hands[p].getCardSet();
+                if ((dead & cards).size() != 0) throw std::invalid_argument("Duplicate card in known hands");
+                dead |= cards;
+                for (const auto& c : hands[p].getCards()) setup.base[p].add(c);
+                for (const auto& c : communityCards) setup.base[p].add(c);
+            }
+            setup.toDeal = 5 - static_cast<int>(communityCards.size());
+            setup.remaining = (CardSet::fullDeck() - dead).toCards();
+
+            // ѭһŴƻ֣ÿ߳ȡһ
+            int outer = setup.toDeal == 0 ? 1 : static_cast<int>(setup.remaining.size());
+            unsigned threadCount = threads ? threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+            threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(outer));
+
+            std::atomic<int> next{ 0 };
+            std::vector<Tally> tallies(threadCount, Tally(setup.players));
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    for (int i = next++; i < outer; i = next++) enumerate(setup, i, tallies[t]);
+                });
+            }
+            for (auto& w : workers) w.join();
+
+            Tally total(setup.players);
+            for (const auto& tally : tallies) total.merge(tally);
+            return total.toResult();
+        }
+
+    private:
+        static const size_t MAX_PLAYERS = 10;
+
+        struct Setup {
+            int players = 0;
+            int toDeal = 0;
+            FastEvaluator::Accumulator base[MAX_PLAYERS];  //  + ֪
+            std::vector<Card> remaining;
+        };
+
+        struct Tally {
+            uint64_t runouts = 0;
+            std::vector<uint64_t> wins, ties;
+            std::vector<double> share;
+            std::vector<std::array<uint64_t, HAND_RANK_COUNT>> rankCounts;
+
+            explicit Tally(int players)
+                : wins(players), ties(players), share(players), rankCounts(players) {
+                for (auto& counts : rankCounts) counts.fill(0);
+            }
+
+            void merge(const Tally& other) {
+                runouts += other.runouts;
+                for (size_t p = 0; p < wins.size(); ++p) {
+                    wins[p] += other.wins[p];
+                    ties[p] += other.ties[p];
+                    share[p] += other.share[p];
+                    for (int r = 0; r < HAND_RANK_COUNT; ++r) rankCounts[p][r] += other.rankCounts[p][r];
+                }
+            }
+
+            ExactEquityResult toResult() const {
+                ExactEquityResult result;
+                result.runouts = runouts;
+                result.rankCounts = rankCounts;
+                double n = runouts ? static_cast<double>(runouts) : 1.0;
+                for (size_t p = 0; p < wins.size(); ++p) {
+                    PlayerEquity e;
+                    e.win = wins[p] / n;
+                    e.tie = ties[p] / n;
+                    e.lose = runouts ? 1.0 - e.win - e.tie : 0.0;
+                    e.equity = share[p] / n;
+                    e.ciLow = e.ciHigh = e.equity;
+                    result.players.push_back(e);
+                }
+                return result;
+            }
+        };
+
+        // öԵ i ʣƿͷз
+        static void enumerate(const Setup& setup, int i, Tally& tally) {
+            if (setup.toDeal == 0) {
+                settle(setup, setup.base, tally);
+                return;
+            }
+
+            FastEvaluator::Accumulator turn[MAX_PLAYERS];
+            for (int p = 0; p < setup.players; ++p) {
+                turn[p] = setup.base[p];
+                turn[p].add(setup.remaining[i]);
+            }
+            if (setup.toDeal == 1) {
+                settle(setup, turn, tally);
+                return;
+            }
+
+            FastEvaluator::Accumulator river[MAX_PLAYERS];
+            for (size_t j = i + 1; j < setup.remaining.size(); ++j) {
+                for (int p = 0; p < setup.players; ++p) {
+                    river[p] = turn[p];
+                    river[p].add(setup.remaining[j]);
+                }
+                settle(setup, river, tally);
+            }
+        }
+
+        static void settle(const Setup& setup, const FastEvaluator::Accumulator* finals, Tally& tally) {
+            uint32_t scores[MAX_PLAYERS];
+            uint32_t best = 0;
+            int winners = 0;
+            for (int p = 0; p < setup.players; ++p) {
+                scores[p] = FastEvaluator::score(finals[p]);
+                tally.rankCounts[p][static_cast<int>(HandStrength(scores[p]).rank())]++;
+                if (scores[p] > best) { best = scores[p]; winners = 1; }
+                else if (scores[p] == best) winners++;
+            }
+            for (int p = 0; p < setup.players; ++p) {
+                if (scores[p] != best) continue;
+                if (winners == 1) tally.wins[p]++;
+                else tally.ties[p]++;
+                tally.share[p] += 1.0 / winners;
+            }
+            tally.runouts++;
+        }
+    };
+
+}
+
+#endif
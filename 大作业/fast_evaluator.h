@@ -0,0 +1,299 @@
+#ifndef FAST_EVALUATOR_H
+#define FAST_EVALUATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include "poker.h"
+#include "texas_holdem_evaluator.h"
+
+namespace rules {
+
+    // ʽ Evaluator һ£κζѷ
+    //
+    // ֱӴŴõ HandStrength::value()score ĴС˳˳
+    //
+    // ְͬ13ֵ0-4ϣְͬûɫ13λ
+    // 7ͬʱͬʱк«ͬĽս
+    class FastEvaluator {
+    public:
+        static const int MAX_CARDS = 7;
+
+        // ѼƵĵɫ롣ȷƺ֪ƣ
+        // ֮һż·ƣÿδͷͳ
+        struct Accumulator {
+            uint8_t counts[13] = { 0 };
+            uint16_t suitMask[4] = { 0 };
+            uint8_t suitCount[4] = { 0 };
+            int n = 0;
+
+            void add(const Card& card) {
+                if (n >= MAX_CARDS) {
+                    throw std::invalid_argument("Too many cards for FastEvaluator");
+                }
+                int r = rankIndex(card.rank());
+                int s = static_cast<int>(card.suit());
+                counts[r]++;
+                suitMask[s] |= static_cast<uint16_t>(1u << r);
+                suitCount[s]++;
+                n++;
+            }
+        };
+
+        static uint32_t score(const Accumulator& acc) {
+            const Tables& t = tables();
+            for (int s = 0; s < 4; ++s) {
+                if (acc.suitCount[s] >= 5) return t.flush[acc.suitMask[s]];
+            }
+            return t.plain[t.base[acc.n] + hashCounts(acc.counts, acc.n)];
+        }
+
+
+        //  Evaluator::evaluateHand ӿͬõл
+        static HandStrength evaluateHand(const std::vector<Card>& cards) {
+            return HandStrength(score(cards));
+        }
+
+        static HandStrength evaluateHand(CardSet cards) {
+            return HandStrength(score(cards));
+        }
+
+        static std::vector<int> determineWinners(
+            const std::vector<std::vector<Card>>& allHands,
+            const std::vector<Card>& communityCards
+        ) {
+            // ֻͳһΣٵӸ
+            Accumulator board;
+            for (const auto& c : communityCards) board.add(c);
+
+            std::vector<int> winners;
+            uint32_t best = 0;
+            for (size_t i = 0; i < allHands.size(); ++i) {
+                Accumulator acc = board;
+                for (const auto& c : allHands[i]) acc.add(c);
+
+                uint32_t s = score(acc);
+                if (winners.empty() || s > best) {
+                    best = s;
+                    winners.clear();
+                }
+                if (s == best) winners.push_back(static_cast<int>(i));
+            }
+            return winners;
+        }
+
+        static uint32_t score(const std::vector<Card>& cards) {
+            return score(cards.data(), cards.size());
+        }
+
+        // 0-7ƵĴ
+        static uint32_t score(const Card* cards, size_t n) {
+            Accumulator acc;
+            for (size_t i = 0; i < n; ++i) acc.add(cards[i]);
+            return score(acc);
+        }
+
+        // λϰ汾ɫֱȡ CardSet
+        static uint32_t score(CardSet cards) {
+            Accumulator acc;
+            acc.n = cards.size();
+            if (acc.n > MAX_CARDS) {
+                throw std::invalid_argument("Too many cards for FastEvaluator");
+            }
+            for (int s = 0; s < 4; ++s) {
+                acc.suitMask[s] = cards.suitMask(s);
+                acc.suitCount[s] = static_cast<uint8_t>(bitCount(acc.suitMask[s]));
+            }
+            for (int r = 0; r < 13; ++r) {
+                acc.counts[r] = static_cast<uint8_t>(((acc.suitMask[0] >> r) & 1) + ((acc.suitMask[1] >> r) & 1) +
+                    ((acc.suitMask[2] >> r) & 1) + ((acc.suitMask[3] >> r) & 1));
+            }
+            return score(acc);
+        }
+
+    private:
+        struct Tables {
+            std::vector<uint32_t> flush;   // 8192ɫ
+            std::vector<uint32_t> plain;   // ϣ
+            uint32_t base[MAX_CARDS + 2];  //  plain еʼλ
+        };
+
+        // N[n][s]Ϊnÿ0-4ܺΪs
+        // offset[i][s][c]iλȡcʣܺΪsʱֵҪӵֵ
+        struct CountTable {
+            uint32_t n[14][MAX_CARDS + 1];
+            uint32_t offset[13][MAX_CARDS + 1][5];
+            CountTable() {
+                for (int len = 0; len <= 13; ++len) {
+                    for (int sum = 0; sum <= MAX_CARDS; ++sum) {
+                        if (len == 0) { n[len][sum] = (sum == 0); continue; }
+                        uint32_t total = 0;
+                        for (int v = 0; v <= 4 && v <= sum; ++v) total += n[len - 1][sum - v];
+                        n[len][sum] = total;
+                    }
+                }
+                for (int i = 0; i < 13; ++i) {
+                    for (int sum = 0; sum <= MAX_CARDS; ++sum) {
+                        uint32_t acc = 0;
+                        for (int c = 0; c <= 4; ++c) {
+                            offset[i][sum][c] = acc;
+                            if (c <= sum) acc += n[12 - i][sum - c];
+                        }
+                    }
+                }
+            }
+        };
+
+        static const CountTable& countTable() {
+            static const CountTable table;
+            return table;
+        }
+
+        // ͬܺеֵ
+        static uint32_t hashCounts(const uint8_t counts[13], int total) {
+            const CountTable& ct = countTable();
+            uint32_t index = 0;
+            int remaining = total;
+            for (int i = 0; i < 13; ++i) {
+                index += ct.offset[i][remaining][counts[i]];
+                remaining -= counts[i];
+            }
+            return index;
+        }
+
+        // kickers Ϊ2-14
+        static uint32_t pack(HandRank rank, const int* kickers, int count) {
+            HandStrength strength(rank, {});
+            for (int i = 0; i < count; ++i) strength.addKicker(rankFromIndex(kickers[i] - 2));
+            return strength.value();
+        }
+
+        // ˳ӶƵ2-14û˳ӷ0
+        static int straightHigh(uint16_t mask) {
+            for (int top = 12; top >= 4; --top) {
+                uint16_t run = static_cast<uint16_t>(0x1F << (top - 4));
+                if ((mask & run) == run) return top + 2;
+            }
+            const uint16_t wheel = 0x100F;  // A-2-3-4-5
+            return (mask & wheel) == wheel ? 5 : 0;
+        }
+
+        static uint32_t flushScore(uint16_t mask) {
+            int high = straightHigh(mask);
+            if (high == 14) return pack(HandRank::ROYAL_FLUSH, &high, 1);
+            if (high != 0) return pack(HandRank::STRAIGHT_FLUSH, &high, 1);
+
+            int kickers[5];
+            int k = 0;
+            for (int r = 12; r >= 0 && k < 5; --r) {
+                if (mask & (1 << r)) kickers[k++] = r + 2;
+            }
+            return pack(HandRank::FLUSH, kickers, k);
+        }
+
+        // ͬʱɵ
+        static uint32_t plainScore(const uint8_t counts[13], int total) {
+            // , г߽˳
+            int kickers[13];
+            int k = 0;
+            for (int c = 4; c >= 1; --c) {
+                for (int r = 12; r >= 0; --r) {
+                    if (counts[r] == c) kickers[k++] = r + 2;
+                }
+            }
+
+            uint16_t present = 0;
+            int pairs = 0, trips = 0, quads = 0;
+            for (int r = 0; r < 13; ++r) {
+                if (counts[r]) present |= static_cast<uint16_t>(1 << r);
+                if (counts[r] == 2) pairs++;
+                if (counts[r] == 3) trips++;
+                if (counts[r] == 4) quads++;
+            }
+
+            if (quads) {
+                // ֮ȡʣһ
+                int best[2] = { kickers[0], 0 };
+                for (int r = 12; r >= 0; --r) {
+                    if (counts[r] && counts[r] != 4) { best[1] = r + 2; break; }
+                }
+                return pack(HandRank::FOUR_OF_A_KIND, best, best[1] ? 2 : 1);
+            }
+            if (trips && (trips >= 2 || pairs)) {
+                // ڶҲɵ
+                int best[2] = { kickers[0], 0 };
+                for (int r = 12; r >= 0; --r) {
+                    if (counts[r] >= 2 && r + 2 != kickers[0]) { best[1] = r + 2; break; }
+                }
+                return pack(HandRank::FULL_HOUSE, best, 2);
+            }
+
+            int high = total >= 5 ? straightHigh(present) : 0;
+            if (high) return pack(HandRank::STRAIGHT, &high, 1);
+
+            if (trips) return packWithSingles(HandRank::THREE_OF_A_KIND, kickers[0], 3, counts);
+            if (pairs >= 2) {
+                // ԵĵҲΪ߽
+                int best[3] = { kickers[0], kickers[1], 0 };
+                for (int r = 12; r >= 0; --r) {
+                    if (counts[r] && r + 2 != best[0] && r + 2 != best[1]) { best[2] = r + 2; break; }
+                }
+                return pack(HandRank::TWO_PAIR, best, best[2] ? 3 : 2);
+            }
+            if (pairs) return packWithSingles(HandRank::ONE_PAIR, kickers[0], 2, counts);
+            return packWithSingles(HandRank::HIGH_CARD, 0, 0, counts);
+        }
+
+        // Ƶռ used ţ֮ӵţ5
+        static uint32_t packWithSingles(HandRank rank, int made, int used,
+            const uint8_t counts[13]) {
+            int best[5];
+            int k = 0;
+            if (made) best[k++] = made;
+            for (int r = 12; r >= 0 && used < 5; --r) {
+                if (counts[r] == 1) { best[k++] = r + 2; used++; }
+            }
+            return pack(rank, best, k);
+        }
+
+        static Tables buildTables() {
+            Tables t;
+            t.flush.assign(1 << 13, 0);
+            for (uint32_t mask = 0; mask < (1u << 13); ++mask) {
+                int bits = 0;
+                for (uint32_t m = mask; m; m &= m - 1) bits++;
+                if (bits >= 5) t.flush[mask] = flushScore(static_cast<uint16_t>(mask));
+            }
+
+            const CountTable& ct = countTable();
+            t.base[0] = 0;
+            for (int n = 0; n <= MAX_CARDS; ++n) t.base[n + 1] = t.base[n] + ct.n[13][n];
+            t.plain.assign(t.base[MAX_CARDS + 1], 0);
+
+            // öÿֵ0-4ţ7
+            uint8_t counts[13] = { 0 };
+            fillPlain(t, counts, 0, 0);
+            return t;
+        }
+
+        static void fillPlain(Tables& t, uint8_t counts[13], int pos, int total) {
+            if (pos == 13) {
+                t.plain[t.base[total] + hashCounts(counts, total)] = plainScore(counts, total);
+                return;
+            }
+            for (int c = 0; c <= 4 && total + c <= MAX_CARDS; ++c) {
+                counts[pos] = static_cast<uint8_t>(c);
+                fillPlain(t, counts, pos + 1, total + c);
+            }
+            counts[pos] = 0;
+        }
+
+        static const Tables& tables() {
+            static const Tables t = buildTables();
+            return t;
+        }
+    };
+
+}
+
+#endif
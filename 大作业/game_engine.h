@@ -0,0 +1,412 @@
+#ifndef GAME_ENGINE_H
+#define GAME_ENGINE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include "poker.h"
+#include "rng.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+#include "showdown.h"
+
+// ĵ˿˹棺2-10λäעע֡ȫ߳ء̯
+namespace engine {
+
+    using Poker::Card;
+    using Poker::CardSet;
+    using Poker::Deck;
+
+    const int MAX_SEATS = 10;
+
+    enum class Street : uint8_t {
+        Preflop,   // ǰ
+        Flop,      // 
+        Turn,      // ת
+        River,     // 
+        Finished   // ֽƻʤ̯ƣ
+    };
+
+    enum class ActionType : uint8_t {
+        Fold,   // 
+        Check,  // 
+        Call,   // ע
+        Raise,  // ע/עamount Ϊעıܶ
+        AllIn   // ȫ
+    };
+
+    struct Action {
+        ActionType type = ActionType::Fold;
+        int32_t amount = 0;
+
+        static Action fold() { return { ActionType::Fold, 0 }; }
+        static Action check() { return { ActionType::Check, 0 }; }
+        static Action call() { return { ActionType::Call, 0 }; }
+        static Action raiseTo(int32_t total) { return { ActionType::Raise, total }; }
+        static Action allIn() { return { ActionType::AllIn, 0 }; }
+    };
+
+    struct TableConfig {
+        int seats = 2;
+        int32_t smallBlind = 50;
+        int32_t bigBlind = 100;
+    };
+
+    struct SeatState {
+        CardSet hole;             // 
+        int32_t stack = 0;        // ʣ
+        int32_t bet = 0;          // ע
+        int32_t committed = 0;    // ۼͶ
+        int32_t won = 0;          // ֽʱӮõĳ
+        bool inHand = false;      // δ
+        bool allIn = false;
+    };
+
+    // һƵȫ״ֱ̬Ӹƣڿʱͷã𲽹
+    struct HandState {
+        TableConfig config;
+        Street street = Street::Finished;
+        uint8_t button = 0;
+        uint8_t toAct = 0;
+        uint8_t boardCount = 0;     // ѹĹ
+        uint16_t needsAction = 0;   // ֻҪжλλ룩
+        uint16_t mayRaise = 0;      // ֻܼעλλ룩жֻע´
+        int32_t currentBet = 0;     // ע
+        int32_t lastRaise = 0;      // һעķ
+        uint8_t raises = 0;         // ֵļעעȫ£
+        uint8_t board[5] = { 0 };   // Ƶ
+        SeatState seat[MAX_SEATS];
+
+        int32_t pot() const {
+            int32_t total = 0;
+            for (int i = 0; i < config.seats; ++i) total += seat[i].committed;
+            return total;
+        }
+
+        Card boardCard(int i) const { return Card::fromIndex(board[i]); }
+
+        CardSet boardSet() const {
+            CardSet set;
+            for (int i = 0; i < boardCount; ++i) set.add(boardCard(i));
+            return set;
+        }
+
+        bool finished() const { return street == Street::Finished; }
+    };
+
+    // ǰж߿
+    struct LegalActions {
+        bool canCheck = false;
+        bool canCall = false;
+        bool canRaise = false;
+        int32_t callAmount = 0;    // עҪĳ
+        int32_t minRaiseTo = 0;    // Сע
+        int32_t maxRaiseTo = 0;    // עȫ£
+    };
+
+    class GameEngine {
+    public:
+        // ʼµһ֣stacks Ϊλ룬Ϊ0λ룻deck ɵ÷ϴ
+        static HandState startHand(const TableConfig& config, const int32_t* stacks, int button, Deck& deck) {
+            HandState s = prepare(config, stacks, button);
+            for (int i = 0; i < config.seats; ++i) {
+                if (s.seat[i].inHand) s.seat[i].hole = deck.dealSet(2);
+            }
+            for (auto& c : s.board) c = static_cast<uint8_t>(deck.deal().index());
+            postBlinds(s);
+            return s;
+        }
+
+        // ƣֻʵҪ
+        template <class Rng>
+        static HandState startHand(const TableConfig& config, const int32_t* stacks, int button, Rng& rng) {
+            HandState s = prepare(config, stacks, button);
+            Deck deck;
+            for (int i = 0; i < config.seats; ++i) {
+                if (s.seat[i].inHand) s.seat[i].hole = deck.dealRandomSet(rng, 2);
+            }
+            for (auto& c : s.board) c = static_cast<uint8_t>(deck.dealRandom(rng).index());
+            postBlinds(s);
+            return s;
+        }
+
+        static LegalActions legalActions(const HandState& s) {
+            LegalActions legal;
+            if (s.finished()) return legal;
+            const SeatState& p = s.seat[s.toAct];
+            int32_t toCall = s.currentBet - p.bet;
+            legal.canCheck = toCall == 0;
+            legal.canCall = toCall > 0;
+            legal.callAmount = std::min(toCall, p.stack);
+            legal.maxRaiseTo = p.bet + p.stack;
+            legal.minRaiseTo = std::min(s.currentBet + std::max(s.lastRaise, s.config.bigBlind), legal.maxRaiseTo);
+            // жԲһעȫ£ֻܸע
+            legal.canRaise = legal.maxRaiseTo > s.currentBet && ((s.mayRaise >> s.toAct) & 1);
+            return legal;
+        }
+
+        // ִеǰжߵĶǷ׳ std::invalid_argument
+        static void apply(HandState& s, Action action) {
+            if (s.finished()) throw std::logic_error("Hand is already finished");
+            int seat = s.toAct;
+            SeatState& p = s.seat[seat];
+            LegalActions legal = legalActions(s);
+
+            switch (action.type) {
+            case ActionType::Fold:
+                p.inHand = false;
+                break;
+            case ActionType::Check:
+                if (!legal.canCheck) throw std::invalid_argument("Cannot check facing a bet");
+                break;
+            case ActionType::Call:
+                if (!legal.canCall) throw std::invalid_argument("Nothing to call");
+                putIn(p, legal.callAmount);
+                break;
+            case ActionType::Raise:
+                if (!legal.canRaise || action.amount > legal.maxRaiseTo || action.amount < legal.minRaiseTo) {
+                    throw std::invalid_argument("Illegal raise amount");
+                }
+                raiseTo(s, seat, action.amount);
+                break;
+            case ActionType::AllIn:
+                if (p.stack == 0) throw std::invalid_argument("Player is already all-in");
+                if (legal.maxRaiseTo > s.currentBet) {
+                    if (!legal.canRaise) throw std::invalid_argument("Betting is not reopened");
+                    raiseTo(s, seat, legal.maxRaiseTo);
+                }
+                else putIn(p, p.stack);
+                break;
+            }
+            s.needsAction &= static_cast<uint16_t>(~(1u << seat));
+            s.mayRaise &= static_cast<uint16_t>(~(1u << seat));
+            advance(s);
+        }
+
+        // Ͷֲغͱ߳أÿ inHand ʸƽ֣ۼӵ won
+        // ̯ƽûнʱҲ¼Ͷ·
+        static void splitPots(int seats, int button, const int32_t* committed, uint16_t inHand,
+            const rules::ShowdownResult& ranking, int32_t* won) {
+            // ͬͶСУ10ֱӲ룩
+            int32_t levels[MAX_SEATS];
+            int levelCount = 0;
+            for (int i = 0; i < seats; ++i) {
+                int32_t c = committed[i];
+                if (c == 0 || std::find(levels, levels + levelCount, c) != levels + levelCount) continue;
+                int k = levelCount++;
+                for (; k > 0 && levels[k - 1] > c; --k) levels[k] = levels[k - 1];
+                levels[k] = c;
+            }
+
+            int32_t previous = 0;
+            uint16_t carryEligible = 0;
+            int32_t carry = 0;
+            for (int l = 0; l < levelCount; ++l) {
+                int32_t level = levels[l];
+                int32_t amount = carry;
+                uint16_t eligible = 0;
+                for (int i = 0; i < seats; ++i) {
+                    amount += std::max(0, std::min(committed[i], level) - previous);
+                    if (((inHand >> i) & 1) && committed[i] >= level) eligible |= static_cast<uint16_t>(1u << i);
+                }
+                previous = level;
+                // һûеңͶƣһӮ
+                if (!eligible) {
+                    eligible = carryEligible;
+                }
+                if (!eligible) { carry = amount; continue; }
+                carry = 0;
+                carryEligible = eligible;
+                award(seats, button, ranking.best(eligible), amount, won);
+            }
+            if (carry) award(seats, button, ranking.best(carryEligible), carry, won);
+        }
+
+    private:
+        static HandState prepare(const TableConfig& config, const int32_t* stacks, int button) {
+            if (config.seats < 2 || config.seats > MAX_SEATS) {
+                throw std::invalid_argument("Table must have 2 to 10 seats");
+            }
+            POKER_COUNT(HandsStarted);
+            if (config.smallBlind < 0 || config.bigBlind <= 0) {
+                throw std::invalid_argument("Invalid blinds");
+            }
+            if (button < 0 || button >= config.seats) {
+                throw std::invalid_argument("Button must be a seat at the table");
+            }
+            HandState s;
+            s.config = config;
+            int players = 0;
+            for (int i = 0; i < config.seats; ++i) {
+                s.seat[i].stack = stacks[i];
+                s.seat[i].inHand = stacks[i] > 0;
+                if (s.seat[i].inHand) players++;
+            }
+            if (players < 2) throw std::invalid_argument("Need at least two players with chips");
+            if (!s.seat[button].inHand) button = nextSeat(s, button, false);
+            s.button = static_cast<uint8_t>(button);
+            s.street = Street::Preflop;
+            return s;
+        }
+
+        static void postBlinds(HandState& s) {
+            int players = countInHand(s);
+            // ʱׯСä
+            int sb = players == 2 ? s.button : nextSeat(s, s.button, false);
+            int bb = nextSeat(s, sb, false);
+            putIn(s.seat[sb], std::min(s.config.smallBlind, s.seat[sb].stack));
+            putIn(s.seat[bb], std::min(s.config.bigBlind, s.seat[bb].stack));
+            s.currentBet = s.config.bigBlind;
+            s.lastRaise = s.config.bigBlind;
+            s.needsAction = actorsMask(s);
+            s.mayRaise = s.needsAction;
+            s.toAct = static_cast<uint8_t>(bb);
+            advance(s);
+        }
+
+        static void putIn(SeatState& p, int32_t amount) {
+            p.stack -= amount;
+            p.bet += amount;
+            p.committed += amount;
+            if (p.stack == 0) p.allIn = true;
+        }
+
+        static void raiseTo(HandState& s, int seat, int32_t total) {
+            SeatState& p = s.seat[seat];
+            int32_t increment = total - s.currentBet;
+            putIn(p, total - p.bet);
+            s.currentBet = total;
+            s.raises++;
+            s.needsAction = actorsMask(s);
+            // һעȫ²ıСעȣҲж»üעȨ
+            if (increment >= s.lastRaise) {
+                s.lastRaise = increment;
+                s.mayRaise = s.needsAction;
+            }
+        }
+
+        // δȫµλ
+        static uint16_t actorsMask(const HandState& s) {
+            uint16_t mask = 0;
+            for (int i = 0; i < s.config.seats; ++i) {
+                if (s.seat[i].inHand && !s.seat[i].allIn) mask |= static_cast<uint16_t>(1u << i);
+            }
+            return mask;
+        }
+
+        static int countInHand(const HandState& s) {
+            int n = 0;
+            for (int i = 0; i < s.config.seats; ++i) n += s.seat[i].inHand;
+            return n;
+        }
+
+        // seat ֮һеλneedAction Ϊ true ʱֻұֻҪж
+        static int nextSeat(const HandState& s, int seat, bool needAction) {
+            for (int k = 1; k <= s.config.seats; ++k) {
+                int i = (seat + k) % s.config.seats;
+                bool ok = needAction ? ((s.needsAction >> i) & 1) != 0 : s.seat[i].inHand;
+                if (ok) return i;
+            }
+            return seat;
+        }
+
+        // ֵһλֽһֻ֣ʣһ˻˿жʱֱӽ
+        static void advance(HandState& s) {
+            if (countInHand(s) == 1) {
+                finish(s);
+                return;
+            }
+            // Ҫעж
+            s.needsAction &= actorsMask(s);
+            if (s.needsAction) {
+                s.toAct = static_cast<uint8_t>(nextSeat(s, s.toAct, true));
+                return;
+            }
+
+            while (true) {
+                if (s.street == Street::River) {
+                    finish(s);
+                    return;
+                }
+                nextStreet(s);
+                // ˻עʱŽһ
+                uint16_t actors = actorsMask(s);
+                if (bitCount(actors) >= 2) {
+                    s.needsAction = actors;
+                    s.mayRaise = actors;
+                    s.toAct = static_cast<uint8_t>(nextSeat(s, s.button, true));
+                    return;
+                }
+            }
+        }
+
+        static int bitCount(uint16_t mask) {
+            return Poker::bitCount(mask);
+        }
+
+        static void nextStreet(HandState& s) {
+            for (int i = 0; i < s.config.seats; ++i) s.seat[i].bet = 0;
+            s.currentBet = 0;
+            s.lastRaise = s.config.bigBlind;
+            s.raises = 0;
+            switch (s.street) {
+            case Street::Preflop: s.street = Street::Flop; s.boardCount = 3; POKER_COUNT(Flop); break;   // 
+            case Street::Flop:    s.street = Street::Turn; s.boardCount = 4; POKER_COUNT(Turn); break;   // ת
+            case Street::Turn:    s.street = Street::River; s.boardCount = 5; POKER_COUNT(River); break; // 
+            default: break;
+            }
+        }
+
+        // ƺͶغͱ߳
+        static void finish(HandState& s) {
+            int n = s.config.seats;
+            uint16_t inHand = 0;
+            CardSet holes[MAX_SEATS];
+            for (int i = 0; i < n; ++i) {
+                holes[i] = s.seat[i].hole;
+                if (s.seat[i].inHand) inHand |= static_cast<uint16_t>(1u << i);
+            }
+            // ֻʣһʱñƣռΨһһ
+            rules::ShowdownResult ranking;
+            ranking.players = n;
+            ranking.tiers = 1;
+            ranking.tier[0] = inHand;
+            if (countInHand(s) > 1) {
+                POKER_COUNT(Showdowns);
+                s.boardCount = 5;
+                rules::Showdown::rank(holes, n, s.boardSet(), ranking, inHand);
+            }
+
+            int32_t committed[MAX_SEATS], won[MAX_SEATS] = { 0 };
+            for (int i = 0; i < n; ++i) committed[i] = s.seat[i].committed;
+            splitPots(n, s.button, committed, inHand, ranking, won);
+
+            for (int i = 0; i < n; ++i) {
+                s.seat[i].won += won[i];
+                s.seat[i].stack += s.seat[i].won;
+                s.seat[i].bet = 0;
+            }
+            s.needsAction = 0;
+            s.mayRaise = 0;
+            s.street = Street::Finished;
+        }
+
+        // Ӯƽһأͷׯ߿ʼη
+        static void award(int seats, int button, uint16_t winnerMask, int32_t amount, int32_t* won) {
+            int winners[MAX_SEATS];
+            int count = 0;
+            for (int k = 1; k <= seats; ++k) {
+                int i = (button + k) % seats;
+                if ((winnerMask >> i) & 1) winners[count++] = i;
+            }
+            int32_t share = amount / count;
+            int32_t odd = amount % count;
+            for (int w = 0; w < count; ++w) {
+                won[winners[w]] += share + (w < odd ? 1 : 0);
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef HAND_ANALYTICS_H
+#define HAND_ANALYTICS_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "poker.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+#include "showdown.h"
+#include "starting_hands.h"
+#include "hand_history.h"
+
+namespace history {
+
+    struct StartingHandStats {
+        uint64_t dealt = 0;     // õƵĴ
+        uint64_t won = 0;       // оӮĴ
+        double netBB = 0;       // Ӯäע
+    };
+
+    struct ActionStats {
+        uint64_t count = 0;
+        double netBB = 0;       // öұֵľӮ֮ͣäע
+    };
+
+    // ͳƽ̸߳һݣϲ
+    struct AnalyticsReport {
+        static const int POT_BUCKETS = 8;
+        static const int STREETS = 4;
+        static const int ACTION_TYPES = 5;
+
+        uint64_t hands = 0;
+        uint64_t showdowns = 0;
+        uint64_t reevaluated = 0;   // ûнжʤ
+        uint64_t skipped = 0;       // ֶԽ磨ļ𻵣ļ¼
+        std::array<StartingHandStats, rules::StartingHands::COUNT> startingHands{};
+        std::array<uint64_t, rules::HAND_RANK_COUNT> showdownRanks{};  // ̯ʱͳִҼƣ
+        std::array<uint64_t, POT_BUCKETS> potBuckets{};                // ׳شСֲ
+        double potSumBB = 0;
+        ActionStats actions[STREETS][ACTION_TYPES];
+
+        // ׳طϽ磨äעһûϽ
+        static double potBucketLimit(int bucket) {
+            static const double LIMITS[POT_BUCKETS - 1] = { 2, 5, 10, 20, 50, 100, 200 };
+            return bucket < POT_BUCKETS - 1 ? LIMITS[bucket] : 0;
+        }
+
+        static int potBucket(double potBB) {
+            int b = 0;
+            while (b < POT_BUCKETS - 1 && potBB > potBucketLimit(b)) b++;
+            return b;
+        }
+
+        void merge(const AnalyticsReport& o) {
+            hands += o.hands;
+            showdowns += o.showdowns;
+            reevaluated += o.reevaluated;
+            skipped += o.skipped;
+            for (size_t i = 0; i < startingHands.size(); ++i) {
+                startingHands[i].dealt += o.startingHands[i].dealt;
+                startingHands[i].won += o.startingHands[i].won;
+                startingHands[i].netBB += o.startingHands[i].netBB;
+            }
+            for (size_t i = 0; i < showdownRanks.size(); ++i) showdownRanks[i] += o.showdownRanks[i];
+            for (size_t i = 0; i < potBuckets.size(); ++i) potBuckets[i] += o.potBuckets[i];
+            potSumBB += o.potSumBB;
+            for (int s = 0; s < STREETS; ++s) {
+                for (int a = 0; a < ACTION_TYPES; ++a) {
+                    actions[s][a].count += o.actions[s][a].count;
+                    actions[s][a].netBB += o.actions[s][a].netBB;
+                }
+            }
+        }
+    };
+
+    // ͳף¼ļƫгɿ飬߳ȡۼӣʱϲ
+    class HandAnalytics {
+    public:
+        static const size_t CHUNK_RECORDS = 16384;  // ÿԼ 9MB
+
+        static AnalyticsReport run(const HandHistoryReader& reader, unsigned threads = 0) {
+            unsigned threadCount = threads ? threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+            size_t chunks = (reader.size() + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+            threadCount = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threadCount, chunks)));
+
+            std::atomic<size_t> next{ 0 };
+            std::vector<AnalyticsReport> partial(threadCount);
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    for (size_t c = next++; c < chunks; c = next++) {
+                        size_t begin = c * CHUNK_RECORDS;
+                        size_t end = std::min(reader.size(), begin + CHUNK_RECORDS);
+                        for (size_t i = begin; i < end; ++i) analyze(reader[i], partial[t]);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+
+            AnalyticsReport total;
+            for (const auto& p : partial) total.merge(p);
+            return total;
+        }
+
+        // ļδÿļڲ
+        static AnalyticsReport run(const std::vector<std::string>& paths, unsigned threads = 0) {
+            AnalyticsReport total;
+            for (const auto& path : paths) {
+                HandHistoryReader reader(path);
+                total.merge(run(reader, threads));
+            }
+            return total;
+        }
+
+        static void analyze(const HandRecord& r, AnalyticsReport& report) {
+            if (!valid(r)) {
+                report.skipped++;
+                return;
+            }
+            report.hands++;
+            double bb = static_cast<double>(r.bigBlind);
+
+            bool folded[MAX_SEATS] = { false };
+            for (int a = 0; a < r.actionCount; ++a) {
+                if (r.actions[a].type == static_cast<uint8_t>(engine::ActionType::Fold)) folded[r.actions[a].seat] = true;
+            }
+
+            int32_t won[MAX_SEATS];
+            std::copy(r.won, r.won + MAX_SEATS, won);
+            bool showdown = (r.flags & HandRecord::SHOWDOWN) != 0;
+            if (showdown) {
+                report.showdowns++;
+                countShowdownRanks(r, folded, report);
+                if (!(r.flags & HandRecord::HAS_RESULT)) {
+                    reevaluate(r, folded, won);
+                    report.reevaluated++;
+                }
+            }
+
+            double pot = r.pot() / bb;
+            report.potBuckets[AnalyticsReport::potBucket(pot)]++;
+            report.potSumBB += pot;
+
+            double net[MAX_SEATS];
+            for (int i = 0; i < r.seats; ++i) {
+                net[i] = (won[i] - r.committed[i]) / bb;
+                if (!r.dealtIn(i)) continue;
+                StartingHandStats& s = report.startingHands[rules::StartingHands::classIndex(r.holeCards(i))];
+                s.dealt++;
+                if (net[i] > 0) s.won++;
+                s.netBB += net[i];
+            }
+
+            for (int a = 0; a < r.actionCount; ++a) {
+                const ActionRecord& act = r.actions[a];
+                if (act.street >= AnalyticsReport::STREETS || act.type >= AnalyticsReport::ACTION_TYPES) continue;
+                ActionStats& s = report.actions[act.street][act.type];
+                s.count++;
+                s.netBB += net[act.seat];
+            }
+        }
+
+    private:
+        // ¼ӳļ±ֶζҪȼ
+        static bool valid(const HandRecord& r) {
+            if (r.seats < 2 || r.seats > MAX_SEATS || r.button >= r.seats || r.bigBlind <= 0) return false;
+            if (r.actionCount > MAX_ACTIONS || r.boardCount > 5) return false;
+            // Ƶ±ҪϷҲظƷĽû
+            Poker::CardSet seen;
+            int cards = 0;
+            for (int i = 0; i < r.boardCount; ++i) {
+                if (!validCard(r.board[i])) return false;
+                seen.add(Poker::Card::fromIndex(r.board[i]));
+                cards++;
+            }
+            for (int i = 0; i < MAX_SEATS; ++i) {
+                bool dealt = r.hole[i][0] != NO_CARD;
+                if (dealt != (r.hole[i][1] != NO_CARD) || (dealt && i >= r.seats)) return false;
+                if (dealt && (!validCard(r.hole[i][0]) || !validCard(r.hole[i][1]))) return false;
+                if (dealt) {
+                    seen |= r.holeCards(i);
+                    cards += 2;
+                }
+                if (i < r.seats && r.committed[i] < 0) return false;
+            }
+            if (seen.size() != cards) return false;
+            for (int a = 0; a < r.actionCount; ++a) {
+                if (r.actions[a].seat >= r.seats) return false;
+            }
+            return true;
+        }
+
+        static bool validCard(uint8_t index) {
+            return index < 64 && (index & 15) < 13;
+        }
+
+        static void countShowdownRanks(const HandRecord& r, const bool* folded, AnalyticsReport& report) {
+            Poker::CardSet board = r.boardCards();
+            for (int i = 0; i < r.seats; ++i) {
+                if (!r.dealtIn(i) || folded[i]) continue;
+                uint32_t score = rules::FastEvaluator::score(r.holeCards(i) | board);
+                report.showdownRanks[static_cast<int>(rules::HandStrength(score).rank())]++;
+            }
+        }
+
+        // ûдʱٰ¼ͶĹغͱ߳
+        static void reevaluate(const HandRecord& r, const bool* folded, int32_t* won) {
+            Poker::CardSet hands[MAX_SEATS];
+            uint16_t active = 0;
+            for (int i = 0; i < r.seats; ++i) {
+                hands[i] = r.holeCards(i);
+                if (r.dealtIn(i) && !folded[i]) active |= static_cast<uint16_t>(1u << i);
+            }
+            std::fill(won, won + MAX_SEATS, 0);
+            if (!active) return;
+            rules::ShowdownResult ranking;
+            rules::Showdown::rank(hands, r.seats, r.boardCards(), ranking, active);
+            engine::GameEngine::splitPots(r.seats, r.button, r.committed, active, ranking, won);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HAND_DISTRIBUTION_H
+#define HAND_DISTRIBUTION_H
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+
+namespace rules {
+
+    // Ƶṹ
+    struct BoardTexture {
+        int cards = 0;
+        bool paired = false;           // ж
+        bool trips = false;            // 
+        bool flushPossible = false;    // ĳɫ 3 
+        bool flushDraw = false;        // Ҫĳɫ 2 ţ˫ɫ棩
+        bool monotone = false;         // ȫͬһɫ
+        bool rainbow = false;          // ûͬɫ
+        bool straightPossible = false; // ĳ䣨A ҲԵ 1 3 ֵ
+        bool connected = false;        // ڵĵ A-2
+        int highRank = -1;             // rankIndexûйʱΪ -1
+    };
+
+    struct HandDistributionResult {
+        std::array<uint64_t, HAND_RANK_COUNT> counts{};   // ճɸ͵ķ
+        uint64_t runouts = 0;
+        BoardTexture board;
+
+        double probability(HandRank rank) const {
+            return runouts ? static_cast<double>(counts[static_cast<int>(rank)]) / runouts : 0.0;
+        }
+    };
+
+    // ֪ƺ͵ǰƣޡƻתƣʱöʣ෢ƣȷճɸ͵ĸʡ
+    // ǰ C(50,5) ַƣǰŴƻֳԼ 1200 ɸ߳ȡ
+    // ÿط˳㸴ۼֻһƺ
+    class HandDistribution {
+    public:
+        static HandDistributionResult run(const HoleCards& hole, const std::vector<Card>& communityCards,
+            unsigned threads = 0) {
+            if (!hole.hasCards()) throw std::invalid_argument("Hole cards are required");
+            return run(hole.getCardSet(), CardSet::of(communityCards), threads);
+        }
+
+        static HandDistributionResult run(CardSet hole, CardSet board, unsigned threads = 0) {
+            if (hole.size() != 2) throw std::invalid_argument("Hole cards must be exactly two cards");
+            int known = board.size();
+            if (known != 0 && (known < 3 || known > 5)) {
+                throw std::invalid_argument("Board must be empty, a flop, a turn or a river");
+            }
+            if (!(hole & board).empty()) throw std::invalid_argument("Hole cards overlap the board");
+
+            Setup setup;
+            for (CardSet rest = hole | board; !rest.empty();) setup.base.add(rest.popFirst());
+            setup.toDeal = 5 - known;
+            setup.remaining = (CardSet::fullDeck() - hole - board).toCards();
+
+            // ÿݹǰ prefix ŴƵһȡ
+            int prefix = std::min(setup.toDeal, 2);
+            std::vector<std::array<int, 2>> items;
+            int n = static_cast<int>(setup.remaining.size());
+            if (prefix == 0) items.push_back({ { -1, -1 } });
+            for (int i = 0; prefix >= 1 && i < n; ++i) {
+                if (prefix == 1) items.push_back({ { i, -1 } });
+                for (int j = i + 1; prefix == 2 && j < n; ++j) items.push_back({ { i, j } });
+            }
+
+            unsigned threadCount = threads ? threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+            if (setup.toDeal < 3) threadCount = 1;   // ƺ 1081 ַƣֵÿ߳
+            threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(items.size()));
+
+            std::atomic<size_t> next{ 0 };
+            std::vector<std::array<uint64_t, HAND_RANK_COUNT>> counts(threadCount);
+            for (auto& c : counts) c.fill(0);
+            auto work = [&](unsigned t) {
+                uint64_t local[HAND_RANK_COUNT] = { 0 };   // дأ̵߳ļͬһ
+                for (size_t k = next++; k < items.size(); k = next++) {
+                    FastEvaluator::Accumulator acc = setup.base;
+                    int start = 0;
+                    for (int index : items[k]) {
+                        if (index < 0) break;
+                        acc.add(setup.remaining[index]);
+                        start = index + 1;
+                    }
+                    walk(setup, acc, start, setup.toDeal - prefix, local);
+                }
+                std::copy(local, local + HAND_RANK_COUNT, counts[t].begin());
+            };
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < threadCount; ++t) workers.emplace_back(work, t);
+            work(0);
+            for (auto& w : workers) w.join();
+
+            HandDistributionResult result;
+            for (const auto& c : counts) {
+                for (int r = 0; r < HAND_RANK_COUNT; ++r) result.counts[r] += c[r];
+            }
+            for (uint64_t c : result.counts) result.runouts += c;
+            result.board = texture(board);
+            return result;
+        }
+
+        static BoardTexture texture(CardSet board) {
+            BoardTexture t;
+            t.cards = board.size();
+            uint16_t seen = 0, twice = 0, three = 0;
+            int maxSuit = 0;
+            for (int s = 0; s < 4; ++s) {
+                uint16_t m = board.suitMask(s);
+                three |= twice & m;
+                twice |= seen & m;
+                seen |= m;
+                int count = 0;
+                for (uint16_t x = m; x; x &= x - 1) count++;
+                maxSuit = std::max(maxSuit, count);
+            }
+            if (t.cards == 0) return t;
+
+            t.paired = twice != 0;
+            t.trips = three != 0;
+            t.flushPossible = maxSuit >= 3;
+            t.flushDraw = maxSuit == 2 && t.cards < 5;
+            t.monotone = t.cards >= 3 && maxSuit == t.cards;
+            t.rainbow = maxSuit == 1;
+
+            // A ͬʱСĵ
+            uint32_t x = static_cast<uint32_t>(seen) << 1 | ((seen >> 12) & 1);
+            t.connected = (x & (x >> 1)) != 0;
+            for (int k = 0; k < 10 && !t.straightPossible; ++k) {
+                int count = 0;
+                for (uint32_t w = (x >> k) & 0x1F; w; w &= w - 1) count++;
+                t.straightPossible = count >= 3;
+            }
+            t.highRank = 12;
+            while (!((seen >> t.highRank) & 1)) t.highRank--;
+            return t;
+        }
+
+    private:
+        struct Setup {
+            FastEvaluator::Accumulator base;   //  + ֪
+            int toDeal = 0;
+            std::vector<Card> remaining;
+        };
+
+        //  remaining[start] ѡ depth ţ㸴ۼ
+        static void walk(const Setup& setup, const FastEvaluator::Accumulator& acc, int start, int depth, uint64_t* counts) {
+            if (depth == 0) {
+                counts[static_cast<int>(HandStrength(FastEvaluator::score(acc)).rank())]++;
+                return;
+            }
+            int n = static_cast<int>(setup.remaining.size());
+            for (int i = start; i <= n - depth; ++i) {
+                FastEvaluator::Accumulator next = acc;
+                next.add(setup.remaining[i]);
+                walk(setup, next, i + 1, depth - 1, counts);
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef HAND_HISTORY_H
+#define HAND_HISTORY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include "poker.h"
+#include "game_engine.h"
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// ףļͷ֮Ƕ¼ÿһֱӳ䵽ڴ水±
+namespace history {
+
+    const int MAX_SEATS = engine::MAX_SEATS;
+    const int MAX_ACTIONS = 48;           // ֲ¼ TRUNCATED ־
+    const uint8_t NO_CARD = 0xFF;
+
+    // һζäע㶯ֻ committed У
+    struct ActionRecord {
+        uint8_t seat;
+        uint8_t type;      // engine::ActionType
+        uint8_t street;    // engine::Street
+        uint8_t reserved;
+        int32_t amount;    // ζͶĳ
+    };
+    static_assert(sizeof(ActionRecord) == 8, "ActionRecord must be 8 bytes");
+
+    struct HandRecord {
+        enum Flags : uint8_t {
+            SHOWDOWN = 1,     // ̯
+            HAS_RESULT = 2,   // won н
+            TRUNCATED = 4     //  MAX_ACTIONS
+        };
+
+        uint64_t handId;
+        uint8_t seats;
+        uint8_t button;
+        uint8_t boardCount;     // ֹĹ
+        uint8_t actionCount;
+        uint8_t flags;
+        uint8_t reserved[3];
+        int32_t smallBlind;
+        int32_t bigBlind;
+        uint8_t hole[MAX_SEATS][2];     // Ƶ Card::index()δΪ NO_CARD
+        uint8_t board[5];
+        uint8_t reserved2[3];
+        int32_t startStack[MAX_SEATS];  // ʱäעǰĳ
+        int32_t committed[MAX_SEATS];   // Ͷ
+        int32_t won[MAX_SEATS];         // Ӯ
+        ActionRecord actions[MAX_ACTIONS];
+
+        Poker::CardSet holeCards(int seat) const {
+            Poker::CardSet set;
+            if (hole[seat][0] != NO_CARD) set.add(Poker::Card::fromIndex(hole[seat][0]));
+            if (hole[seat][1] != NO_CARD) set.add(Poker::Card::fromIndex(hole[seat][1]));
+            return set;
+        }
+
+        Poker::CardSet boardCards() const {
+            Poker::CardSet set;
+            for (int i = 0; i < boardCount; ++i) set.add(Poker::Card::fromIndex(board[i]));
+            return set;
+        }
+
+        bool dealtIn(int seat) const { return hole[seat][0] != NO_CARD; }
+        int32_t net(int seat) const { return won[seat] - committed[seat]; }
+        int32_t pot() const {
+            int32_t total = 0;
+            for (int i = 0; i < seats; ++i) total += committed[i];
+            return total;
+        }
+    };
+    static_assert(sizeof(HandRecord) == 560, "HandRecord layout changed");
+
+    struct FileHeader {
+        char magic[8];        // "PKRHIST"
+        uint32_t version;
+        uint32_t recordSize;
+        uint8_t reserved[48];
+    };
+    static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+
+    const char HISTORY_MAGIC[8] = { 'P', 'K', 'R', 'H', 'I', 'S', 'T', 0 };
+    const uint32_t HISTORY_VERSION = 1;
+
+    // ¼һƣ beginͨ apply ִУ finish ȡü¼
+    class HandRecorder {
+    public:
+        void begin(const engine::HandState& s, uint64_t handId) {
+            std::memset(&record_, 0, sizeof(record_));
+            std::memset(record_.hole, NO_CARD, sizeof(record_.hole));
+            record_.handId = handId;
+            record_.seats = static_cast<uint8_t>(s.config.seats);
+            record_.button = s.button;
+            record_.smallBlind = s.config.smallBlind;
+            record_.bigBlind = s.config.bigBlind;
+            for (int i = 0; i < s.config.seats; ++i) {
+                const engine::SeatState& seat = s.seat[i];
+                record_.startStack[i] = seat.stack + seat.committed;
+                if (seat.hole.size() == 2) {
+                    Poker::CardSet hole = seat.hole;
+                    record_.hole[i][0] = static_cast<uint8_t>(hole.popFirst().index());
+                    record_.hole[i][1] = static_cast<uint8_t>(hole.popFirst().index());
+                }
+            }
+        }
+
+        // ִжʵͶĳ
+        void apply(engine::HandState& s, engine::Action action) {
+            int seat = s.toAct;
+            engine::Street street = s.street;
+            int32_t before = s.seat[seat].committed;
+            engine::GameEngine::apply(s, action);
+            if (record_.actionCount == MAX_ACTIONS) {
+                record_.flags |= HandRecord::TRUNCATED;
+                return;
+            }
+            ActionRecord& a = record_.actions[record_.actionCount++];
+            a.seat = static_cast<uint8_t>(seat);
+            a.type = static_cast<uint8_t>(action.type);
+            a.street = static_cast<uint8_t>(street);
+            a.amount = s.seat[seat].committed - before;
+        }
+
+        const HandRecord& finish(const engine::HandState& s) {
+            int inHand = 0;
+            for (int i = 0; i < s.config.seats; ++i) {
+                record_.committed[i] = s.seat[i].committed;
+                record_.won[i] = s.seat[i].won;
+                inHand += s.seat[i].inHand;
+            }
+            // ƽʱֻһ
+            record_.boardCount = s.boardCount;
+            for (int i = 0; i < 5; ++i) record_.board[i] = i < s.boardCount ? s.board[i] : NO_CARD;
+            if (inHand > 1) record_.flags |= HandRecord::SHOWDOWN;
+            if (s.finished()) record_.flags |= HandRecord::HAS_RESULT;
+            return record_;
+        }
+
+        const HandRecord& record() const { return record_; }
+
+    private:
+        HandRecord record_;
+    };
+
+    // ֻ׷ӵд¼ȿڴ滺壬󽻸̨߳д̣
+    // ÷ֻں̨ûдһʱҪȴ
+    // ļʱļͷĩβļ¼ϴд;жϣص֮ļ¼Ȼ
+    class HandHistoryWriter {
+    public:
+        explicit HandHistoryWriter(const std::string& path, size_t bufferRecords = 4096)
+            : capacity_(bufferRecords ? bufferRecords : 1) {
+            file_ = std::fopen(path.c_str(), "r+b");
+            if (!file_) file_ = std::fopen(path.c_str(), "w+b");
+            if (!file_) throw std::runtime_error("Cannot open " + path);
+            try {
+                prepare();
+            }
+            catch (...) {
+                std::fclose(file_);
+                throw;
+            }
+            current_.reserve(capacity_);
+            pending_.reserve(capacity_);
+            worker_ = std::thread([this]() { run(); });
+        }
+
+        ~HandHistoryWriter() {
+            try {
+                flush();
+            }
+            catch (...) {
+            }
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            worker_.join();
+            std::fclose(file_);
+        }
+
+        HandHistoryWriter(const HandHistoryWriter&) = delete;
+        HandHistoryWriter& operator=(const HandHistoryWriter&) = delete;
+
+        void append(const HandRecord& record) {
+            current_.push_back(record);
+            if (current_.size() >= capacity_) handOff();
+        }
+
+        // ׷ӵļ¼ȫдļ
+        void flush() {
+            if (!current_.empty()) handOff();
+            std::unique_lock<std::mutex> guard(lock_);
+            done_.wait(guard, [this]() { return !busy_; });
+            std::fflush(file_);
+            if (failed_) throw std::runtime_error("Failed to write hand history");
+        }
+
+        uint64_t written() const {
+            std::lock_guard<std::mutex> guard(lock_);
+            return written_;
+        }
+
+    private:
+        size_t capacity_;
+        std::FILE* file_ = nullptr;
+        std::vector<HandRecord> current_;   // ÷дĻ
+        std::vector<HandRecord> pending_;   // ̨߳д̵Ļ
+        std::thread worker_;
+        mutable std::mutex lock_;
+        std::condition_variable wake_, done_;
+        bool busy_ = false;
+        bool stop_ = false;
+        bool failed_ = false;
+        uint64_t written_ = 0;
+
+        // ļдļͷļУļͷصһ¼Ȼλĩβ
+        void prepare() {
+            if (!seek(0, SEEK_END)) throw std::runtime_error("Cannot read hand history");
+            int64_t size = tell();
+            if (size < 0) throw std::runtime_error("Cannot read hand history");
+            if (size == 0) {
+                if (!writeHeader()) throw std::runtime_error("Failed to write hand history");
+                return;
+            }
+            FileHeader h;
+            seek(0, SEEK_SET);
+            if (static_cast<uint64_t>(size) < sizeof(h) || std::fread(&h, sizeof(h), 1, file_) != 1) {
+                throw std::runtime_error("Hand history is truncated");
+            }
+            if (std::memcmp(h.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0) {
+                throw std::runtime_error("Not a hand history file");
+            }
+            if (h.version != HISTORY_VERSION || h.recordSize != sizeof(HandRecord)) {
+                throw std::runtime_error("Unsupported hand history version");
+            }
+            int64_t whole = static_cast<int64_t>(sizeof(FileHeader)) +
+                (size - static_cast<int64_t>(sizeof(FileHeader))) / static_cast<int64_t>(sizeof(HandRecord)) *
+                static_cast<int64_t>(sizeof(HandRecord));
+            if (whole != size && !truncate(whole)) throw std::runtime_error("Cannot repair hand history");
+            seek(0, SEEK_END);
+        }
+
+        // ļܳ 2GBƫһ 64 λWindows  long ֻ 32 λ
+        bool seek(int64_t offset, int origin) {
+#ifdef _WIN32
+            return _fseeki64(file_, offset, origin) == 0;
+#else
+            return fseeko(file_, static_cast<off_t>(offset), origin) == 0;
+#endif
+        }
+
+        int64_t tell() {
+#ifdef _WIN32
+            return _ftelli64(file_);
+#else
+            return static_cast<int64_t>(ftello(file_));
+#endif
+        }
+
+        bool truncate(int64_t size) {
+            std::fflush(file_);
+#ifdef _WIN32
+            return _chsize_s(_fileno(file_), size) == 0;
+#else
+            return ftruncate(fileno(file_), static_cast<off_t>(size)) == 0;
+#endif
+        }
+
+        bool writeHeader() {
+            FileHeader h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+            h.version = HISTORY_VERSION;
+            h.recordSize = sizeof(HandRecord);
+            return std::fwrite(&h, sizeof(h), 1, file_) == 1;
+        }
+
+        // Ⱥ̨дһ飬ٽ
+        void handOff() {
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                done_.wait(guard, [this]() { return !busy_; });
+                current_.swap(pending_);
+                busy_ = true;
+            }
+            current_.clear();
+            wake_.notify_one();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> guard(lock_);
+            while (true) {
+                wake_.wait(guard, [this]() { return busy_ || stop_; });
+                if (!busy_ && stop_) return;
+                size_t n = pending_.size();
+                guard.unlock();
+                bool ok = std::fwrite(pending_.data(), sizeof(HandRecord), n, file_) == n;
+                guard.lock();
+                if (!ok) failed_ = true;
+                written_ += n;
+                busy_ = false;
+                done_.notify_all();
+            }
+        }
+    };
+
+    // ӳļ¼ֱָӳڴ棬
+    class HandHistoryReader {
+    public:
+        explicit HandHistoryReader(const std::string& path) : file_(path) {
+            if (file_.size() < sizeof(FileHeader)) throw std::runtime_error("Hand history is truncated");
+            const FileHeader* h = reinterpret_cast<const FileHeader*>(file_.data());
+            if (std::memcmp(h->magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0) {
+                throw std::runtime_error("Not a hand history file");
+            }
+            if (h->version != HISTORY_VERSION || h->recordSize != sizeof(HandRecord)) {
+                throw std::runtime_error("Unsupported hand history version");
+            }
+            // ĩβļ¼д;жϣ
+            count_ = (file_.size() - sizeof(FileHeader)) / sizeof(HandRecord);
+            records_ = reinterpret_cast<const HandRecord*>(file_.data() + sizeof(FileHeader));
+        }
+
+        size_t size() const { return count_; }
+        const HandRecord& operator[](size_t i) const { return records_[i]; }
+        const HandRecord* begin() const { return records_; }
+        const HandRecord* end() const { return records_ + count_; }
+
+        //  i ¼ļеֽƫ
+        static uint64_t offsetOf(size_t i) { return sizeof(FileHeader) + i * sizeof(HandRecord); }
+
+    private:
+        MappedFile file_;
+        const HandRecord* records_ = nullptr;
+        size_t count_ = 0;
+    };
+
+}
+
+#endif
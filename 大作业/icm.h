@@ -0,0 +1,174 @@
+#ifndef ICM_H
+#define ICM_H
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+
+namespace rules {
+
+    // ģͣICMҳͽ䣬ÿλҵĽ
+    //
+    // ĳõһεĸʣеĳռȳȡ˳ N! ĵݹ飬
+    // ǶԡռǰҼϡ̬滮prob[S] Ϊǰ |S| ǡ S ҵĸʣ
+    // ͬһֻһΡֻõڽλļϣö٣Gosper 
+    // 20  3 λ 1 + 20 + 190 = 211 ϣȫʱΪ 2^20 
+    // ÿļϰŴţǵǰһ飬Ϊ C(n, k) 
+    // 20  3 λʱ 190 22 ȫʱ C(22, 11) Լ 11MB
+    class IcmCalculator {
+    public:
+        static const int MAX_PLAYERS = 22;
+
+        // payouts[k] Ϊ k+1 Ľ𣬶Ĳֺ
+        explicit IcmCalculator(const std::vector<double>& payouts) : payouts_(payouts) {
+            for (double p : payouts_) {
+                if (p < 0) throw std::invalid_argument("Payouts must not be negative");
+            }
+            for (int n = 0; n <= MAX_PLAYERS; ++n) {
+                choose_[n][0] = 1;
+                for (int k = 1; k <= MAX_PLAYERS + 1; ++k) choose_[n][k] = n ? choose_[n - 1][k - 1] + choose_[n - 1][k] : 0;
+            }
+        }
+
+        const std::vector<double>& payouts() const { return payouts_; }
+
+        std::vector<double> equity(const std::vector<double>& stacks) {
+            std::vector<double> result(stacks.size());
+            equity(stacks.data(), static_cast<int>(stacks.size()), result.data(), work_);
+            return result;
+        }
+
+        void equity(const double* stacks, int count, double* out) {
+            equity(stacks, count, out, work_);
+        }
+
+        // 㣨/ʱĴϣ߳ȡһ鲢ʹԼĹ
+        // ÿĴС˵
+        std::vector<std::vector<double>> batch(const std::vector<std::vector<double>>& stackSets,
+            unsigned threads = 0) const {
+            std::vector<std::vector<double>> results(stackSets.size());
+            unsigned threadCount = threads ? threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+            threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(std::max<size_t>(stackSets.size(), 1)));
+
+            std::atomic<size_t> next{ 0 };
+            auto work = [&]() {
+                Workspace workspace;
+                for (size_t k = next++; k < stackSets.size(); k = next++) {
+                    results[k].resize(stackSets[k].size());
+                    equity(stackSets[k].data(), static_cast<int>(stackSets[k].size()), results[k].data(), workspace);
+                }
+            };
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < threadCount; ++t) workers.emplace_back(work);
+            work();
+            for (auto& w : workers) w.join();
+            return results;
+        }
+
+    private:
+        // ǰһ probڱеŴ
+        struct Workspace {
+            std::vector<double> layer, next;
+        };
+
+        std::vector<double> payouts_;
+        uint32_t choose_[MAX_PLAYERS + 1][MAX_PLAYERS + 2];   // C(n, k)k > n ʱΪ 0
+        Workspace work_;
+
+        void equity(const double* stacks, int count, double* out, Workspace& work) const {
+            if (count < 0 || count > MAX_PLAYERS) throw std::invalid_argument("ICM supports at most 22 players");
+
+            // Ϊ 0 Ѿ֣ƽ󼸸
+            double chips[MAX_PLAYERS];
+            int index[MAX_PLAYERS];
+            int n = 0;
+            double total = 0;
+            for (int p = 0; p < count; ++p) {
+                if (stacks[p] < 0) throw std::invalid_argument("Stacks must not be negative");
+                out[p] = 0;
+                if (stacks[p] == 0) continue;
+                chips[n] = stacks[p];
+                index[n++] = p;
+                total += stacks[p];
+            }
+            if (n < count) {
+                double busted = 0;
+                for (int k = n; k < count && k < static_cast<int>(payouts_.size()); ++k) busted += payouts_[k];
+                for (int p = 0; p < count; ++p) {
+                    if (stacks[p] == 0) out[p] = busted / (count - n);
+                }
+            }
+            if (n == 0) return;
+
+            int places = std::min(n, static_cast<int>(payouts_.size()));
+            size_t widest = 1;
+            for (int k = 1; k < places; ++k) widest = std::max<size_t>(widest, choose_[n][k]);
+            if (work.layer.size() < widest) {
+                work.layer.resize(widest);
+                work.next.resize(widest);
+            }
+            double* prob = work.layer.data();
+            double* next = work.next.data();
+            uint32_t limit = 1u << n;
+            double ev[MAX_PLAYERS] = { 0 };
+
+            // ͬļϰСGosper ˳򣩱Ϊ sum C(c_j, j)c_j Ϊ j Ա
+            // һ i 󣬱 i СĳԱλò䣬 i ĺһλ
+            uint32_t base[MAX_PLAYERS + 1];   // ¼ϱ i ޹صĲ֣ i µĳԱ
+            prob[0] = 1.0;
+            for (int k = 0; k < places; ++k) {
+                bool deeper = k + 1 < places;
+                if (deeper) std::fill(next, next + choose_[n][k + 1], 0.0);
+                double payout = payouts_[k];
+                uint32_t rank = 0;
+                for (uint32_t s = k ? (1u << k) - 1 : 0; s < limit; s = k ? nextSubset(s) : limit, ++rank) {
+                    double p = prob[rank];
+                    if (p == 0) continue;
+                    double taken = 0;
+                    int members[MAX_PLAYERS];
+                    int m = 0;
+                    uint32_t shifted = 0;   // гԱһλʱı
+                    for (uint32_t rest = s; rest; rest &= rest - 1, ++m) {
+                        members[m] = Poker::lowestBit(rest);
+                        taken += chips[members[m]];
+                        shifted += choose_[members[m]][m + 2];
+                    }
+                    if (deeper) {
+                        base[0] = shifted;
+                        for (int j = 0; j < k; ++j) {
+                            base[j + 1] = base[j] + choose_[members[j]][j + 1] - choose_[members[j]][j + 2];
+                        }
+                    }
+                    double scale = p / (total - taken);
+                    int seen = 0;   // ѾķǳԱi µĳԱ i - seen
+                    for (uint32_t rest = ~s & (limit - 1); rest; rest &= rest - 1, ++seen) {
+                        int i = Poker::lowestBit(rest);
+                        double q = scale * chips[i];
+                        ev[i] += q * payout;
+                        if (deeper) {
+                            int below = i - seen;
+                            next[base[below] + choose_[i][below + 1]] += q;
+                        }
+                    }
+                }
+                std::swap(prob, next);
+            }
+            for (int i = 0; i < n; ++i) out[index[i]] = ev[i];
+        }
+
+        // λͬһ
+        static uint32_t nextSubset(uint32_t s) {
+            uint32_t low = s & (0u - s);
+            uint32_t ripple = s + low;
+            return (((ripple ^ s) >> 2) / low) | ripple;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef INCREMENTAL_HAND_H
+#define INCREMENTAL_HAND_H
+
+#include <cstdint>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+
+namespace rules {
+
+    // ֻڻйҪʱŻƣѾ˵Ͳ
+    struct DrawStatus {
+        bool flushDraw = false;       // ĳɫ 4 õ
+        bool backdoorFlush = false;   // Ȧĳɫ 3 õƣҪתƺƶ
+        bool openEnded = false;       // ֻϵĵܳ˳ͷ˳˫˳
+        bool gutshot = false;         // ֻһֵܳ˳˳
+        uint16_t straightRanks = 0;   // ܳ˳ĵ rankIndex λ룩ֻõƵ
+
+        bool any() const { return flushDraw || backdoorFlush || openEnded || gutshot; }
+    };
+
+    // ҵɵƽּ빫ơÿμʱһƣ
+    // ֮βѯ O(1)öʱԸ accumulator() ټ
+    class IncrementalHand {
+    public:
+        IncrementalHand() { refresh(); }
+
+        explicit IncrementalHand(CardSet hole) {
+            if (hole.size() != 2) throw std::invalid_argument("Hole cards must be exactly two cards");
+            hole_ = hole;
+            for (CardSet rest = hole; !rest.empty();) acc_.add(rest.popFirst());
+            refresh();
+        }
+
+        explicit IncrementalHand(const HoleCards& hole) : IncrementalHand(hole.getCardSet()) {}
+
+        // һŹ
+        void add(const Card& card) {
+            absorb(card);
+            refresh();
+        }
+
+        // һֵĹƣһӣֻһ
+        void add(CardSet cards) {
+            for (CardSet rest = cards; !rest.empty();) absorb(rest.popFirst());
+            refresh();
+        }
+
+        //  board лûмƣboard Ѽȫ
+        void advanceTo(CardSet board) {
+            if (!(board_ - board).empty()) throw std::invalid_argument("Board does not extend the absorbed cards");
+            if (board == board_) return;
+            add(board - board_);
+        }
+
+        uint32_t score() const { return score_; }
+        HandStrength strength() const { return HandStrength(score_); }
+        HandRank category() const { return category_; }
+        const DrawStatus& draws() const { return draws_; }
+
+        CardSet hole() const { return hole_; }
+        CardSet board() const { return board_; }
+        CardSet cards() const { return hole_ | board_; }
+        const FastEvaluator::Accumulator& accumulator() const { return acc_; }
+
+    private:
+        FastEvaluator::Accumulator acc_;
+        CardSet hole_;
+        CardSet board_;
+        uint32_t score_ = 0;
+        HandRank category_ = HandRank::HIGH_CARD;
+        DrawStatus draws_;
+
+        void absorb(const Card& card) {
+            if ((hole_ | board_).contains(card)) throw std::invalid_argument("Card already in hand");
+            acc_.add(card);
+            board_.add(card);
+        }
+
+        void refresh() {
+            score_ = FastEvaluator::score(acc_);
+            category_ = HandStrength(score_).rank();
+            draws_ = DrawStatus();
+            int boardCards = board_.size();
+            if (boardCards < 3 || boardCards >= 5) return;
+
+            if (category_ < HandRank::FLUSH) {
+                for (int s = 0; s < 4; ++s) {
+                    if (!hole_.suitMask(s)) continue;
+                    if (acc_.suitCount[s] == 4) draws_.flushDraw = true;
+                    if (acc_.suitCount[s] == 3 && boardCards == 3) draws_.backdoorFlush = true;
+                }
+            }
+
+            if (category_ < HandRank::STRAIGHT) {
+                uint16_t all = 0, board = 0;
+                for (int s = 0; s < 4; ++s) {
+                    all |= acc_.suitMask[s];
+                    board |= board_.suitMask(s);
+                }
+                // Լܳ˳ĵ㣨˶У
+                draws_.straightRanks = static_cast<uint16_t>(completing(all) & ~completing(board));
+                int ways = 0;
+                for (uint16_t m = draws_.straightRanks; m; m &= m - 1) ways++;
+                draws_.openEnded = ways >= 2;
+                draws_.gutshot = ways == 1;
+            }
+        }
+
+        // һžܳ˳ĵ 10 ڣA ҲԵ 1 4 ŵģȱ
+        static uint16_t completing(uint16_t ranks) {
+            uint32_t x = static_cast<uint32_t>(ranks) << 1 | ((ranks >> 12) & 1);
+            uint32_t result = 0;
+            for (int k = 0; k < 10; ++k) {
+                uint32_t window = 0x1Fu << k;
+                uint32_t missing = window & ~x;
+                if (missing && !(missing & (missing - 1))) result |= missing;
+            }
+            //  0 λǵ 1  A
+            return static_cast<uint16_t>((result >> 1) | ((result & 1) << 12));
+        }
+    };
+
+}
+
+#endif
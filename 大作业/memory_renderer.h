@@ -0,0 +1,138 @@
+#ifndef MEMORY_RENDERER_H
+#define MEMORY_RENDERER_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "renderer.h"
+
+namespace render {
+
+    // Ƶڴ֡ĺˣͼο⣬ڷϲÿ֡ͼ
+    // 䣩ͼÿһɫڹʱһɣֻ֮ڴ濽
+    class MemoryRenderer : public Renderer {
+    public:
+        struct Stats {
+            uint64_t frames = 0;          // present 
+            uint64_t pixelsWritten = 0;   // д֡
+            uint64_t spriteDraws = 0;
+            uint64_t textDraws = 0;
+            uint64_t atlasDecodes = 0;    // ͼͼֻڹʱ
+        };
+
+        MemoryRenderer(int width, int height, int cardWidth, int cardHeight)
+            : width_(width), height_(height), cardWidth_(cardWidth), cardHeight_(cardHeight),
+              pixels_(static_cast<size_t>(width) * height, 0),
+              background_(pixels_.size()),
+              atlasWidth_(AtlasLayout::COLUMNS * cardWidth),
+              atlas_(static_cast<size_t>(atlasWidth_) * AtlasLayout::ROWS * cardHeight, 0),
+              clip_(0, 0, width, height) {
+            if (width <= 0 || height <= 0 || cardWidth <= 0 || cardHeight <= 0) {
+                throw std::invalid_argument("Invalid framebuffer size");
+            }
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) background_[static_cast<size_t>(y) * width + x] = backgroundPixel(x, y);
+            }
+            decodeAtlas();
+        }
+
+        int width() const override { return width_; }
+        int height() const override { return height_; }
+
+        void setClip(const Rect& clip) override {
+            clip_ = clip.intersected(Rect(0, 0, width_, height_));
+        }
+
+        void drawBackground() override {
+            for (int y = clip_.top; y < clip_.bottom; ++y) {
+                size_t offset = static_cast<size_t>(y) * width_ + clip_.left;
+                std::copy_n(background_.data() + offset, clip_.width(), pixels_.data() + offset);
+            }
+            stats_.pixelsWritten += static_cast<uint64_t>(clip_.width()) * clip_.height();
+        }
+
+        void drawSprite(int slot, int x, int y) override {
+            if (!AtlasLayout::validSlot(slot)) throw std::out_of_range("Invalid atlas slot");
+            Rect source = AtlasLayout::slotRect(slot, cardWidth_, cardHeight_);
+            Rect target = Rect::sized(x, y, cardWidth_, cardHeight_).intersected(clip_);
+            for (int ty = target.top; ty < target.bottom; ++ty) {
+                const uint32_t* from = atlas_.data() +
+                    static_cast<size_t>(source.top + ty - y) * atlasWidth_ + source.left + (target.left - x);
+                std::copy_n(from, target.width(), pixels_.data() + static_cast<size_t>(ty) * width_ + target.left);
+            }
+            stats_.spriteDraws++;
+            stats_.pixelsWritten += static_cast<uint64_t>(target.width()) * target.height();
+        }
+
+        void fillRoundRect(const Rect& rect, Color color) override {
+            fill(rect, color);
+        }
+
+        // û壬ÿַһ 8x16 ɫ
+        void drawText(int x, int y, const std::wstring& text, Color color) override {
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (text[i] != L' ') fill(Rect::sized(x + static_cast<int>(i) * 8 + 1, y + 2, 6, 12), color);
+            }
+            stats_.textDraws++;
+        }
+
+        void present(const std::vector<Rect>&) override {
+            stats_.frames++;
+        }
+
+        uint32_t pixel(int x, int y) const { return pixels_[static_cast<size_t>(y) * width_ + x]; }
+        const std::vector<uint32_t>& pixels() const { return pixels_; }
+        const Stats& stats() const { return stats_; }
+        void resetStats() {
+            uint64_t decodes = stats_.atlasDecodes;
+            stats_ = Stats();
+            stats_.atlasDecodes = decodes;
+        }
+
+        // Ĵɫʱжĳ
+        static Color slotColor(int slot) {
+            return slot == AtlasLayout::CARD_BACK ? rgb(30, 60, 160)
+                : rgb(200 + slot % 16 * 4, 40 + slot * 3, 255 - slot * 2);
+        }
+
+        static Color backgroundPixel(int x, int y) {
+            return rgb(0, 90 + (y >> 4) % 40, 40 + (x >> 5) % 20);
+        }
+
+    private:
+        int width_, height_;
+        int cardWidth_, cardHeight_;
+        std::vector<uint32_t> pixels_;
+        std::vector<uint32_t> background_;
+        int atlasWidth_;
+        std::vector<uint32_t> atlas_;
+        Rect clip_;
+        Stats stats_;
+
+        void decodeAtlas() {
+            for (int slot = 0; slot < 64; ++slot) {
+                if (!AtlasLayout::validSlot(slot)) continue;
+                Rect r = AtlasLayout::slotRect(slot, cardWidth_, cardHeight_);
+                for (int y = r.top; y < r.bottom; ++y) {
+                    for (int x = r.left; x < r.right; ++x) {
+                        bool border = x == r.left || y == r.top || x == r.right - 1 || y == r.bottom - 1;
+                        atlas_[static_cast<size_t>(y) * atlasWidth_ + x] = border ? rgb(0, 0, 0) : slotColor(slot);
+                    }
+                }
+                stats_.atlasDecodes++;
+            }
+        }
+
+        void fill(const Rect& rect, Color color) {
+            Rect target = rect.intersected(clip_);
+            for (int y = target.top; y < target.bottom; ++y) {
+                std::fill_n(pixels_.data() + static_cast<size_t>(y) * width_ + target.left, target.width(), color);
+            }
+            stats_.pixelsWritten += static_cast<uint64_t>(target.width()) * target.height();
+        }
+    };
+
+}
+
+#endif
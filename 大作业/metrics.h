@@ -0,0 +1,313 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+// ȵ·ļͺʱֲ POKER_METRICS ʱűȥCMake ѡ POKER_METRICS
+// δʱĺչΪ䣬ûκοб뵥Ԫʹͬһá
+//
+// ÿ߳дԼݿ飬ֻи̻߳д relaxed ĶдԭӼӣ
+// մһ߳رݿ鲢߳͡˳ݿУһ߳̽ʹã
+// Ѽ¼ݲᶪʧ
+namespace metrics {
+
+    enum class Counter : int {
+        EvaluateHand,       // Evaluator::evaluateHand
+        DetermineWinners,   // Evaluator::determineWinners
+        DeckShuffles,
+        CardsDealt,
+        HandsStarted,       // GameEngine::startHand
+        Flop,               // 뷭ơתơ
+        Turn,
+        River,
+        Showdowns,
+        AnytimeDecision,    // ai::AnytimeDecider::decide
+        CfrDecision,        // ai::CfrStrategy::choose
+        COUNT
+    };
+
+    // ʱͬӦ
+    enum class Timer : int {
+        EvaluateHand,
+        DetermineWinners,
+        AnytimeDecision,
+        CfrDecision,
+        COUNT
+    };
+
+    const int COUNTERS = static_cast<int>(Counter::COUNT);
+    const int TIMERS = static_cast<int>(Timer::COUNT);
+
+    inline const char* name(Counter c) {
+        static const char* names[COUNTERS] = {
+            "evaluate_hand", "determine_winners", "deck_shuffles", "cards_dealt", "hands_started",
+            "flop", "turn", "river", "showdowns", "anytime_decision", "cfr_decision"
+        };
+        return names[static_cast<int>(c)];
+    }
+
+    inline const char* name(Timer t) {
+        static const char* names[TIMERS] = { "evaluate_hand", "determine_winners", "anytime_decision", "cfr_decision" };
+        return names[static_cast<int>(t)];
+    }
+
+    // ʱֲ룩 2 ݷ飬ÿٷ 4 ٷλȡڵϽ
+    struct TimerSnapshot {
+        static const int SUB_BITS = 2;
+        static const int BUCKETS = 64 << SUB_BITS;
+
+        uint64_t count = 0;       // ¼Ĵʱʱڵô
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t buckets[BUCKETS] = { 0 };
+
+        double meanNs() const { return count ? static_cast<double>(totalNs) / count : 0; }
+
+        // q ȡ 0-1
+        double percentileNs(double q) const {
+            if (count == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(q * count + 0.999999);
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (int b = 0; b < BUCKETS; ++b) {
+                seen += buckets[b];
+                if (seen >= rank) return static_cast<double>(std::min(upperBound(b), maxNs));
+            }
+            return static_cast<double>(maxNs);
+        }
+
+        static int bucketOf(uint64_t ns) {
+            const uint64_t SUB = 1u << SUB_BITS;
+            if (ns < SUB) return static_cast<int>(ns);
+            int log = 63;
+            while (!(ns >> log)) log--;
+            int sub = static_cast<int>((ns >> (log - SUB_BITS)) & (SUB - 1));
+            return ((log - SUB_BITS + 1) << SUB_BITS) + sub;
+        }
+
+        static uint64_t upperBound(int bucket) {
+            const uint64_t SUB = 1u << SUB_BITS;
+            if (bucket < static_cast<int>(SUB)) return bucket;
+            int log = (bucket >> SUB_BITS) + SUB_BITS - 1;
+            uint64_t sub = bucket & (SUB - 1);
+            return ((SUB + sub + 1) << (log - SUB_BITS)) - 1;
+        }
+    };
+
+    struct Snapshot {
+        int threads = 0;          // ¼ݵ߳ͬʱڵֵ
+        uint64_t counters[COUNTERS] = { 0 };
+        TimerSnapshot timers[TIMERS];
+
+        uint64_t counter(Counter c) const { return counters[static_cast<int>(c)]; }
+        const TimerSnapshot& timer(Timer t) const { return timers[static_cast<int>(t)]; }
+
+        // Ŀõʱڵֵ޷յֵ
+        Snapshot since(const Snapshot& earlier) const {
+            Snapshot d = *this;
+            for (int c = 0; c < COUNTERS; ++c) d.counters[c] -= earlier.counters[c];
+            for (int t = 0; t < TIMERS; ++t) {
+                d.timers[t].count -= earlier.timers[t].count;
+                d.timers[t].totalNs -= earlier.timers[t].totalNs;
+                for (int b = 0; b < TimerSnapshot::BUCKETS; ++b) d.timers[t].buckets[b] -= earlier.timers[t].buckets[b];
+            }
+            return d;
+        }
+
+        std::string text() const {
+            std::string out;
+            char line[160];
+            for (int c = 0; c < COUNTERS; ++c) {
+                std::snprintf(line, sizeof(line), "%-20s %14llu\n", name(static_cast<Counter>(c)),
+                    static_cast<unsigned long long>(counters[c]));
+                out += line;
+            }
+            std::snprintf(line, sizeof(line), "\n%-20s %10s %10s %10s %10s %10s\n", "timer (ns)", "samples", "mean", "p50", "p99", "max");
+            out += line;
+            for (int t = 0; t < TIMERS; ++t) {
+                const TimerSnapshot& s = timers[t];
+                std::snprintf(line, sizeof(line), "%-20s %10llu %10.0f %10.0f %10.0f %10llu\n", name(static_cast<Timer>(t)),
+                    static_cast<unsigned long long>(s.count), s.meanNs(), s.percentileNs(0.5), s.percentileNs(0.99),
+                    static_cast<unsigned long long>(s.maxNs));
+                out += line;
+            }
+            return out;
+        }
+
+        std::string json() const {
+            std::string out = "{\"threads\": " + std::to_string(threads) + ", \"counters\": {";
+            for (int c = 0; c < COUNTERS; ++c) {
+                out += std::string(c ? ", " : "") + "\"" + name(static_cast<Counter>(c)) + "\": " + std::to_string(counters[c]);
+            }
+            out += "}, \"timers_ns\": {";
+            char buf[256];
+            for (int t = 0; t < TIMERS; ++t) {
+                const TimerSnapshot& s = timers[t];
+                std::snprintf(buf, sizeof(buf),
+                    "%s\"%s\": {\"samples\": %llu, \"mean\": %.1f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"max\": %llu}",
+                    t ? ", " : "", name(static_cast<Timer>(t)), static_cast<unsigned long long>(s.count), s.meanNs(),
+                    s.percentileNs(0.5), s.percentileNs(0.9), s.percentileNs(0.99), static_cast<unsigned long long>(s.maxNs));
+                out += buf;
+            }
+            return out + "}}";
+        }
+    };
+
+    class Registry {
+    public:
+        // ʱǷͳ
+        static bool enabled() {
+#if defined(POKER_METRICS)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static void add(Counter c, uint64_t n) {
+            bump(local().counters[static_cast<int>(c)], n);
+        }
+
+        // ڼֵ mask+1 ıʱ trueڳʱ
+        static bool sample(Counter c, uint64_t mask) {
+            std::atomic<uint64_t>& counter = local().counters[static_cast<int>(c)];
+            uint64_t v = counter.load(std::memory_order_relaxed);
+            counter.store(v + 1, std::memory_order_relaxed);
+            return (v & mask) == 0;
+        }
+
+        static void record(Timer t, uint64_t ns) {
+            Histogram& h = local().timers[static_cast<int>(t)];
+            bump(h.count, 1);
+            bump(h.totalNs, ns);
+            bump(h.buckets[std::min(TimerSnapshot::bucketOf(ns), TimerSnapshot::BUCKETS - 1)], 1);
+            if (ns > h.maxNs.load(std::memory_order_relaxed)) h.maxNs.store(ns, std::memory_order_relaxed);
+        }
+
+        // ̣߳ڼ¼̣߳Ǹڶȡʱ̵ֵ
+        static Snapshot snapshot() {
+            Snapshot s;
+            for (Block* b = head().load(std::memory_order_acquire); b; b = b->next) {
+                s.threads++;
+                for (int c = 0; c < COUNTERS; ++c) s.counters[c] += b->counters[c].load(std::memory_order_relaxed);
+                for (int t = 0; t < TIMERS; ++t) {
+                    const Histogram& h = b->timers[t];
+                    TimerSnapshot& out = s.timers[t];
+                    out.count += h.count.load(std::memory_order_relaxed);
+                    out.totalNs += h.totalNs.load(std::memory_order_relaxed);
+                    out.maxNs = std::max(out.maxNs, h.maxNs.load(std::memory_order_relaxed));
+                    for (int k = 0; k < TimerSnapshot::BUCKETS; ++k) out.buckets[k] += h.buckets[k].load(std::memory_order_relaxed);
+                }
+            }
+            return s;
+        }
+
+    private:
+        struct Histogram {
+            std::atomic<uint64_t> count{ 0 }, totalNs{ 0 }, maxNs{ 0 };
+            std::atomic<uint64_t> buckets[TimerSnapshot::BUCKETS];
+
+            Histogram() { for (auto& b : buckets) b.store(0, std::memory_order_relaxed); }
+        };
+
+        struct Block {
+            std::atomic<uint64_t> counters[COUNTERS];
+            Histogram timers[TIMERS];
+            std::atomic<bool> inUse{ true };
+            Block* next = nullptr;
+
+            Block() { for (auto& c : counters) c.store(0, std::memory_order_relaxed); }
+        };
+
+        // ߳˳ʱݿ齻һ߳
+        struct Release {
+            Block* block = nullptr;
+            ~Release() {
+                if (block) block->inUse.store(false, std::memory_order_release);
+                current() = nullptr;
+            }
+        };
+
+        // ֻб߳дҪԭӼ
+        static void bump(std::atomic<uint64_t>& v, uint64_t n) {
+            v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        static Block*& current() {
+            static thread_local Block* block = nullptr;
+            return block;
+        }
+
+        static std::atomic<Block*>& head() {
+            static std::atomic<Block*> list{ nullptr };
+            return list;
+        }
+
+        static Block& local() {
+            Block* b = current();
+            return b ? *b : attach();
+        }
+
+        // ÿ̵߳һμ¼ʱִУһеݿ飬û½һ嵽ͷ
+        static Block& attach() {
+            Block* b = nullptr;
+            for (Block* p = head().load(std::memory_order_acquire); p && !b; p = p->next) {
+                bool idle = false;
+                if (p->inUse.compare_exchange_strong(idle, true, std::memory_order_acquire)) b = p;
+            }
+            if (!b) {
+                b = new Block;
+                b->next = head().load(std::memory_order_relaxed);
+                while (!head().compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed)) {}
+            }
+            static thread_local Release release;
+            release.block = b;
+            current() = b;
+            return *b;
+        }
+    };
+
+    // ʱactive Ϊ false ʱʲôҲ
+    class ScopedTimer {
+    public:
+        ScopedTimer(Timer timer, bool active) : timer_(timer), active_(active) {
+            if (active_) start_ = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            if (!active_) return;
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+            Registry::record(timer_, static_cast<uint64_t>(ns));
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Timer timer_;
+        bool active_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+}
+
+#if defined(POKER_METRICS)
+#define POKER_METRICS_CAT2(a, b) a##b
+#define POKER_METRICS_CAT(a, b) POKER_METRICS_CAT2(a, b)
+#define POKER_COUNT(name) ::metrics::Registry::add(::metrics::Counter::name, 1)
+#define POKER_COUNT_N(name, n) ::metrics::Registry::add(::metrics::Counter::name, static_cast<uint64_t>(n))
+// ͬÿ every Σ2 ݣʱһεǰ
+#define POKER_TIMED(name, every) ::metrics::ScopedTimer POKER_METRICS_CAT(pokerTimer, __LINE__)( \
+    ::metrics::Timer::name, ::metrics::Registry::sample(::metrics::Counter::name, (every) - 1))
+#else
+#define POKER_COUNT(name) ((void)0)
+#define POKER_COUNT_N(name, n) ((void)0)
+#define POKER_TIMED(name, every) ((void)0)
+#endif
+
+#endif
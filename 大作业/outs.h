@@ -0,0 +1,141 @@
+#ifndef OUTS_H
+#define OUTS_H
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "texas_holdem_evaluator.h"
+#include "fast_evaluator.h"
+
+namespace rules {
+
+    // һλҵĳƣһŹƣƵļϣsize() 
+    struct PlayerOuts {
+        bool leading = false;                 // ǰȣֻһλʱΪ false
+        CardSet outs;                         // ֮ȣֻһλʱΪ͵
+        CardSet splitOuts;                    // ֮˲
+        CardSet dirty;                        // ͵ָ󣬲
+        CardSet byRank[HAND_RANK_COUNT];      // outs ƺͷ
+        CardSet overcards;                    // outs ϱȹƶĵƳһԵ
+
+        CardSet flushOuts() const {
+            return byRank[static_cast<int>(HandRank::FLUSH)] | byRank[static_cast<int>(HandRank::STRAIGHT_FLUSH)] |
+                byRank[static_cast<int>(HandRank::ROYAL_FLUSH)];
+        }
+        CardSet straightOuts() const { return byRank[static_cast<int>(HandRank::STRAIGHT)]; }
+        int count() const { return outs.size(); }
+    };
+
+    struct OutsResult {
+        static const int MAX_PLAYERS = 10;
+
+        PlayerOuts players[MAX_PLAYERS];
+        int count = 0;
+        uint16_t leaders = 0;   // ǰȵңλ룩
+        CardSet unseen;         // öٵʣ
+    };
+
+    // Ƽ㣺ƻתʱöʣƣλδֵƣһ֮˭ȡ
+    // ƺ͸ҵۼֻһΣÿÿλֻۼһٲ
+    //
+    // λʱøҴӲȱΪȵƣͬʱ˶ʹȻȵ
+    // Ϊ dirtyơֻһλңֵ֪ƣʱͱ
+    // ҲǹԼɵ
+    class Outs {
+    public:
+        static void compute(const CardSet* hands, int count, CardSet board, OutsResult& out) {
+            if (count < 1 || count > OutsResult::MAX_PLAYERS) throw std::invalid_argument("Outs needs 1 to 10 hands");
+            if (board.size() != 3 && board.size() != 4) throw std::invalid_argument("Outs needs a flop or turn board");
+
+            FastEvaluator::Accumulator boardAcc;
+            for (CardSet rest = board; !rest.empty();) boardAcc.add(rest.popFirst());
+
+            FastEvaluator::Accumulator acc[OutsResult::MAX_PLAYERS];
+            HandRank current[OutsResult::MAX_PLAYERS];
+            uint16_t holeRanks[OutsResult::MAX_PLAYERS];
+            CardSet dead = board;
+            uint32_t best = 0;
+            out.count = count;
+            out.leaders = 0;
+            for (int p = 0; p < count; ++p) {
+                if (hands[p].size() != 2) throw std::invalid_argument("Hole cards must be exactly two cards");
+                if (!(dead & hands[p]).empty()) throw std::invalid_argument("Duplicate card in hands or board");
+                dead |= hands[p];
+                acc[p] = boardAcc;
+                holeRanks[p] = 0;
+                for (CardSet rest = hands[p]; !rest.empty();) {
+                    Card c = rest.popFirst();
+                    acc[p].add(c);
+                    holeRanks[p] |= static_cast<uint16_t>(1u << rankIndex(c.rank()));
+                }
+                uint32_t s = FastEvaluator::score(acc[p]);
+                current[p] = HandStrength(s).rank();
+                if (!out.leaders || s > best) { best = s; out.leaders = 0; }
+                if (s == best) out.leaders |= static_cast<uint16_t>(1u << p);
+                out.players[p] = PlayerOuts();
+            }
+            if (count == 1) out.leaders = 0;
+            for (int p = 0; p < count; ++p) out.players[p].leading = out.leaders == (1u << p);
+
+            // Ƶжϸ
+            uint16_t boardRanks = 0;
+            for (int s = 0; s < 4; ++s) boardRanks |= board.suitMask(s);
+            int boardHigh = 12;
+            while (!((boardRanks >> boardHigh) & 1)) boardHigh--;
+
+            out.unseen = CardSet::fullDeck() - dead;
+            uint32_t scores[OutsResult::MAX_PLAYERS];
+            for (CardSet rest = out.unseen; !rest.empty();) {
+                Card c = rest.popFirst();
+                int boardRank = -1;   // Լźͣͱʱ
+
+                uint16_t next = 0;
+                best = 0;
+                for (int p = 0; p < count; ++p) {
+                    FastEvaluator::Accumulator a = acc[p];
+                    a.add(c);
+                    scores[p] = FastEvaluator::score(a);
+                    if (!next || scores[p] > best) { best = scores[p]; next = 0; }
+                    if (scores[p] == best) next |= static_cast<uint16_t>(1u << p);
+                }
+
+                for (int p = 0; p < count; ++p) {
+                    PlayerOuts& po = out.players[p];
+                    uint16_t me = static_cast<uint16_t>(1u << p);
+                    HandRank rank = HandStrength(scores[p]).rank();
+                    bool improved = rank > current[p];
+                    if (improved && boardRank < 0) {
+                        FastEvaluator::Accumulator b = boardAcc;
+                        b.add(c);
+                        boardRank = static_cast<int>(HandStrength(FastEvaluator::score(b)).rank());
+                    }
+                    improved = improved && static_cast<int>(rank) > boardRank;
+                    bool isOut = count == 1 ? improved : next == me && out.leaders != me;
+                    if (count > 1 && (next & me) && next != me && !(out.leaders & me)) po.splitOuts.add(c);
+                    else if (count > 1 && improved && !(next & me)) po.dirty.add(c);
+                    if (!isOut) continue;
+                    po.outs.add(c);
+                    po.byRank[static_cast<int>(rank)].add(c);
+                    int r = rankIndex(c.rank());
+                    if (rank == HandRank::ONE_PAIR && ((holeRanks[p] >> r) & 1) && r > boardHigh) po.overcards.add(c);
+                }
+            }
+        }
+
+        static OutsResult compute(const std::vector<HoleCards>& hands, const std::vector<Card>& communityCards) {
+            if (hands.size() > static_cast<size_t>(OutsResult::MAX_PLAYERS)) {
+                throw std::invalid_argument("Outs needs 1 to 10 hands");
+            }
+            CardSet sets[OutsResult::MAX_PLAYERS];
+            for (size_t p = 0; p < hands.size(); ++p) sets[p] = hands[p].getCardSet();
+            OutsResult result;
+            compute(sets, static_cast<int>(hands.size()), CardSet::of(communityCards), result);
+            return result;
+        }
+    };
+
+}
+
+#endif
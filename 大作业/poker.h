@@ -5,6 +5,14 @@
 #include <string>
 #include <algorithm>
 #include <random>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "rng.h"
+#include "metrics.h"
 
 namespace Poker {
 
@@ -25,11 +33,73 @@ namespace Poker {
         King   // K
     };
 
+    // ±꣺2-A Ӧ 0-12A 
+    inline int rankIndex(Rank r) {
+        return r == Rank::Ace ? 12 : static_cast<int>(r) - 2;
+    }
+
+    inline Rank rankFromIndex(int index) {
+        return index == 12 ? Rank::Ace : static_cast<Rank>(index + 2);
+    }
+
+    // λ㸨
+    inline int bitCount(uint64_t x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(x));
+#elif defined(__GNUC__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    // λ±꣨x Ϊ0
+    inline int lowestBit(uint64_t x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return static_cast<int>(i);
+#elif defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int i = 0;
+        while (!(x & 1)) { x >>= 1; ++i; }
+        return i;
+#endif
+    }
+
+    // λ±꣨x Ϊ0
+    inline int highestBit(uint64_t x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return static_cast<int>(i);
+#elif defined(__GNUC__)
+        return 63 - __builtin_clzll(x);
+#else
+        int i = 63;
+        while (!(x >> i)) --i;
+        return i;
+#endif
+    }
+
     // ˿
     class Card {
     public:
         Card(Suit s, Rank r) : suit_(s), rank_(r) {}
 
+        // Ƶλ±꣺ɫ * 16 + ±
+        int index() const {
+            return static_cast<int>(suit_) * 16 + rankIndex(rank_);
+        }
+
+        static Card fromIndex(int index) {
+            return Card(static_cast<Suit>(index >> 4), rankFromIndex(index & 15));
+        }
+
         Suit suit() const { return suit_; }
         Rank rank() const { return rank_; }
 
@@ -66,29 +136,105 @@ namespace Poker {
         }
     };
 
+    // Ƽϣÿռһλÿֻɫռ16λеĵ13λ2-A
+    // ϲΪλȥΪλ
+    class CardSet {
+    public:
+        static const uint64_t RANK_MASK = 0x1FFF;
+        static const uint64_t FULL_DECK = 0x1FFF1FFF1FFF1FFFULL;
+
+        CardSet() = default;
+        explicit CardSet(uint64_t bits) : bits_(bits) {}
+        CardSet(const Card& card) : bits_(1ULL << card.index()) {}
+
+        static CardSet of(const std::vector<Card>& cards) {
+            CardSet set;
+            for (const auto& c : cards) set.add(c);
+            return set;
+        }
+
+        static CardSet fullDeck() { return CardSet(FULL_DECK); }
+
+        uint64_t bits() const { return bits_; }
+        int size() const { return bitCount(bits_); }
+        bool empty() const { return bits_ == 0; }
+
+        void add(const Card& card) { bits_ |= 1ULL << card.index(); }
+        void remove(const Card& card) { bits_ &= ~(1ULL << card.index()); }
+        bool contains(const Card& card) const { return (bits_ >> card.index()) & 1; }
+
+        // ĳɫ13λ
+        uint16_t suitMask(int suit) const {
+            return static_cast<uint16_t>((bits_ >> (16 * suit)) & RANK_MASK);
+        }
+        uint16_t suitMask(Suit suit) const { return suitMask(static_cast<int>(suit)); }
+
+        // ֹĵ
+        uint16_t rankMask() const {
+            return static_cast<uint16_t>((bits_ | bits_ >> 16 | bits_ >> 32 | bits_ >> 48) & RANK_MASK);
+        }
+
+        // ȡƳ±Сһ
+        Card popFirst() {
+            int i = lowestBit(bits_);
+            bits_ &= bits_ - 1;
+            return Card::fromIndex(i);
+        }
+
+        std::vector<Card> toCards() const {
+            std::vector<Card> cards;
+            cards.reserve(size());
+            for (CardSet rest = *this; !rest.empty();) cards.push_back(rest.popFirst());
+            return cards;
+        }
+
+        CardSet operator|(CardSet other) const { return CardSet(bits_ | other.bits_); }
+        CardSet operator&(CardSet other) const { return CardSet(bits_ & other.bits_); }
+        CardSet operator-(CardSet other) const { return CardSet(bits_ & ~other.bits_); }
+        CardSet& operator|=(CardSet other) { bits_ |= other.bits_; return *this; }
+        CardSet& operator&=(CardSet other) { bits_ &= other.bits_; return *this; }
+        CardSet& operator-=(CardSet other) { bits_ &= ~other.bits_; return *this; }
+        bool operator==(CardSet other) const { return bits_ == other.bits_; }
+        bool operator!=(CardSet other) const { return bits_ != other.bits_; }
+
+    private:
+        uint64_t bits_ = 0;
+    };
+
     // ˿
+    // ±ڹ̶52У[0, size) Ϊδƣ[size, limit) Ϊѷƣ
+    // [limit, 52) ΪƳơֻƶ߽磬restore() ջѷ
     class Deck {
     public:
         Deck() { reset(); }
 
+        // ָֻƵƶѣ±˳
+        explicit Deck(CardSet cards) {
+            for (CardSet rest = cards; !rest.empty();) cards_[size_++] = static_cast<uint8_t>(rest.popFirst().index());
+            limit_ = size_;
+        }
+
         // ƶѣ˳ƣ
         void reset() {
-            cards_.clear();
-            for (int s = 0; s < 4; ++s) {     // 4ֻɫ
-                for (int r = 1; r <= 13; ++r) { // 13
-                    cards_.emplace_back(
-                        static_cast<Suit>(s),
-                        static_cast<Rank>(r)
-                    );
-                }
-            }
+            std::copy(orderedDeck().begin(), orderedDeck().end(), cards_);
+            size_ = limit_ = 52;
         }
 
-        // ϴ
+        // ջѷƣָ˳ȻƳO(1)
+        void restore() { size_ = limit_; }
+
+        // ϴƣʹñ̵߳ĬϷ
         void shuffle() {
-            std::random_device rd;
-            std::mt19937 g(rd());
-            std::shuffle(cards_.begin(), cards_.end(), g);
+            shuffle(threadRng());
+        }
+
+        // ָķϴƣ̶ӵķɸֽ
+        template <class Rng>
+        void shuffle(Rng& rng) {
+            POKER_COUNT(DeckShuffles);
+            for (int i = size_ - 1; i > 0; --i) {
+                std::swap(cards_[i], cards_[randomIndex(rng, i + 1)]);
+            }
         }
 
         // һ
@@ -96,16 +242,108 @@ namespace Poker {
             if (isEmpty()) {
                 throw std::out_of_range("Deck is empty");
             }
-            Card top = cards_.back();
-            cards_.pop_back();
-            return top;
+            POKER_COUNT(CardsDealt);
+            return Card::fromIndex(cards_[--size_]);
         }
 
-        bool isEmpty() const { return cards_.empty(); }
-        size_t size() const { return cards_.size(); }
+        // һƣֻʵʷһ Fisher-YatesҪϴ
+        template <class Rng>
+        Card dealRandom(Rng& rng) {
+            if (isEmpty()) {
+                throw std::out_of_range("Deck is empty");
+            }
+            POKER_COUNT(CardsDealt);
+            return takeRandom(rng);
+        }
+
+        // һη n Ƶ
+        CardSet dealSet(int n) {
+            if (n > size_) {
+                throw std::out_of_range("Deck is empty");
+            }
+            POKER_COUNT_N(CardsDealt, n);
+            CardSet dealt;
+            for (int i = 0; i < n; ++i) dealt.add(Card::fromIndex(cards_[--size_]));
+            return dealt;
+        }
+
+        //  n Ƶ
+        template <class Rng>
+        CardSet dealRandomSet(Rng& rng, int n) {
+            if (n > size_) {
+                throw std::out_of_range("Deck is empty");
+            }
+            POKER_COUNT_N(CardsDealt, n);
+            CardSet dealt;
+            for (int i = 0; i < n; ++i) dealt.add(takeRandom(rng));
+            return dealt;
+        }
+
+        // Ƴƣ֪ơƵȣrestore() ֮Ҳٳ
+        void removeCards(CardSet dead) {
+            // źãδơѷơƳ
+            uint8_t kept[52];
+            int n = 0, live = 0;
+            for (int i = 0; i < limit_; ++i) {
+                if (!((dead.bits() >> cards_[i]) & 1)) {
+                    kept[n++] = cards_[i];
+                    if (i < size_) live++;
+                }
+            }
+            int limit = n;
+            for (int i = 0; i < limit_; ++i) {
+                if ((dead.bits() >> cards_[i]) & 1) kept[n++] = cards_[i];
+            }
+            std::copy(kept, kept + n, cards_);
+            size_ = live;
+            limit_ = limit;
+        }
+
+        // ʣƵļ
+        CardSet toCardSet() const {
+            uint64_t bits = 0;
+            for (int i = 0; i < size_; ++i) bits |= 1ULL << cards_[i];
+            return CardSet(bits);
+        }
+
+        bool isEmpty() const { return size_ == 0; }
+        size_t size() const { return static_cast<size_t>(size_); }
 
     private:
-        std::vector<Card> cards_;
+        uint8_t cards_[52];
+        int size_ = 0;
+        int limit_ = 0;
+
+        static const std::array<uint8_t, 52>& orderedDeck() {
+            static const std::array<uint8_t, 52> ordered = []() {
+                std::array<uint8_t, 52> a{};
+                int n = 0;
+                for (int s = 0; s < 4; ++s) {     // 4ֻɫ
+                    for (int r = 1; r <= 13; ++r) { // 13
+                        a[n++] = static_cast<uint8_t>(Card(static_cast<Suit>(s), static_cast<Rank>(r)).index());
+                    }
+                }
+                return a;
+            }();
+            return ordered;
+        }
+
+        template <class Rng>
+        static int randomIndex(Rng& rng, int n) {
+            std::uniform_int_distribution<int> pick(0, n - 1);
+            return pick(rng);
+        }
+
+        static int randomIndex(Xoshiro256& rng, int n) {
+            return static_cast<int>(rng.bounded(static_cast<uint32_t>(n)));
+        }
+
+        // ʣһ Fisher-Yates ÷֤ƶѲ
+        template <class Rng>
+        Card takeRandom(Rng& rng) {
+            std::swap(cards_[randomIndex(rng, size_)], cards_[size_ - 1]);
+            return Card::fromIndex(cards_[--size_]);
+        }
     };
 
 } 
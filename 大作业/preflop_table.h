@@ -0,0 +1,225 @@
+#ifndef PREFLOP_TABLE_H
+#define PREFLOP_TABLE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "fast_evaluator.h"
+#include "equity.h"
+#include "mapped_file.h"
+#include "starting_hands.h"
+
+namespace rules {
+
+    // ʤʱļͷ֮ݣ
+    //   float vsRandom[169][9]    1-9 ֵʤ
+    //   float headsUp[169][169]  ʱжеʤ
+    struct PreflopFileHeader {
+        char magic[8];            // "PFEQTBL"
+        uint32_t version;
+        uint32_t classes;         // 169
+        uint32_t maxOpponents;    // 9
+        uint32_t headerSize;
+        uint64_t trials;          // ÿģ
+        uint64_t seed;
+        uint64_t payloadSize;     // ֽ
+        uint64_t checksum;        // ݵ FNV-1a 64 λУ
+        uint64_t reserved;
+    };
+    static_assert(sizeof(PreflopFileHeader) == 64, "PreflopFileHeader must be 64 bytes");
+
+    const char PREFLOP_MAGIC[8] = { 'P', 'F', 'E', 'Q', 'T', 'B', 'L', 0 };
+    const uint32_t PREFLOP_VERSION = 1;
+    const int PREFLOP_MAX_OPPONENTS = 9;
+
+    inline uint64_t fnv1a64(const uint8_t* data, size_t size) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    // ʱֻʤʱӳļֱӳڴϲʱֻļͷ
+    class PreflopTable {
+    public:
+        // verifyChecksum Ϊ true ʱУȫݣҪһļ
+        static PreflopTable open(const std::string& path, bool verifyChecksum = false) {
+            PreflopTable table;
+            table.file_.open(path);
+            if (table.file_.size() < sizeof(PreflopFileHeader)) {
+                throw std::runtime_error("Preflop table is truncated");
+            }
+            const PreflopFileHeader* h = reinterpret_cast<const PreflopFileHeader*>(table.file_.data());
+            if (std::memcmp(h->magic, PREFLOP_MAGIC, sizeof(PREFLOP_MAGIC)) != 0) {
+                throw std::runtime_error("Not a preflop equity table");
+            }
+            if (h->version != PREFLOP_VERSION) {
+                throw std::runtime_error("Unsupported preflop table version");
+            }
+            if (h->classes != StartingHands::COUNT || h->maxOpponents != PREFLOP_MAX_OPPONENTS ||
+                h->headerSize != sizeof(PreflopFileHeader) || h->payloadSize != payloadBytes() ||
+                table.file_.size() != sizeof(PreflopFileHeader) + h->payloadSize) {
+                throw std::runtime_error("Preflop table has an unexpected layout");
+            }
+            table.header_ = h;
+            table.vsRandom_ = reinterpret_cast<const float*>(table.file_.data() + sizeof(PreflopFileHeader));
+            table.headsUp_ = table.vsRandom_ + StartingHands::COUNT * PREFLOP_MAX_OPPONENTS;
+            if (verifyChecksum && !table.verify()) {
+                throw std::runtime_error("Preflop table checksum mismatch");
+            }
+            return table;
+        }
+
+        bool verify() const {
+            return fnv1a64(file_.data() + sizeof(PreflopFileHeader), header_->payloadSize) == header_->checksum;
+        }
+
+        const PreflopFileHeader& header() const { return *header_; }
+
+        //  opponents1-9ֵʤ
+        float equity(int cls, int opponents) const {
+            return vsRandom_[cls * PREFLOP_MAX_OPPONENTS + opponents - 1];
+        }
+
+        float equity(CardSet hole, int opponents) const {
+            if (opponents < 1 || opponents > PREFLOP_MAX_OPPONENTS) {
+                throw std::out_of_range("Opponent count must be 1 to 9");
+            }
+            return equity(StartingHands::classIndex(hole), opponents);
+        }
+
+        // ʱ hero  villain ʤʣϵƽ
+        float headsUp(int hero, int villain) const {
+            return headsUp_[hero * StartingHands::COUNT + villain];
+        }
+
+        static uint64_t payloadBytes() {
+            return sizeof(float) * (StartingHands::COUNT * PREFLOP_MAX_OPPONENTS +
+                StartingHands::COUNT * StartingHands::COUNT);
+        }
+
+    private:
+        MappedFile file_;
+        const PreflopFileHeader* header_ = nullptr;
+        const float* vsRandom_ = nullptr;
+        const float* headsUp_ = nullptr;
+    };
+
+    // ʤʱ MonteCarloEquityȡľģ
+    class PreflopTableBuilder {
+    public:
+        struct Options {
+            uint64_t trials = 20000;  // ÿģ
+            unsigned threads = 0;     // 0 ʾȫ
+            uint64_t seed = 1;        // ͬӺʹͬļ
+        };
+
+        static std::vector<float> build(const Options& options) {
+            std::vector<float> payload(payloadBytes() / sizeof(float));
+            float* vsRandom = payload.data();
+            float* headsUp = vsRandom + StartingHands::COUNT * PREFLOP_MAX_OPPONENTS;
+
+            for (int cls = 0; cls < StartingHands::COUNT; ++cls) {
+                HoleCards hero;
+                hero.receiveCards(StartingHands::combos(cls).front());
+                for (int opponents = 1; opponents <= PREFLOP_MAX_OPPONENTS; ++opponents) {
+                    EquityOptions eo;
+                    eo.maxTrials = options.trials;
+                    eo.threads = options.threads;
+                    eo.seed = options.seed + static_cast<uint64_t>(cls * PREFLOP_MAX_OPPONENTS + opponents);
+                    EquityResult r = MonteCarloEquity::run({ hero }, {}, opponents, eo);
+                    vsRandom[cls * PREFLOP_MAX_OPPONENTS + opponents - 1] = static_cast<float>(r.players[0].equity);
+                }
+            }
+
+            buildHeadsUp(options, headsUp);
+            return payload;
+        }
+
+        static void write(const std::string& path, const Options& options) {
+            std::vector<float> payload = build(options);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(payload.data());
+
+            PreflopFileHeader h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, PREFLOP_MAGIC, sizeof(PREFLOP_MAGIC));
+            h.version = PREFLOP_VERSION;
+            h.classes = StartingHands::COUNT;
+            h.maxOpponents = PREFLOP_MAX_OPPONENTS;
+            h.headerSize = sizeof(PreflopFileHeader);
+            h.trials = options.trials;
+            h.seed = options.seed;
+            h.payloadSize = payloadBytes();
+            h.checksum = fnv1a64(bytes, payloadBytes());
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot create " + path);
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            out.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(payloadBytes()));
+            if (!out) throw std::runtime_error("Cannot write " + path);
+        }
+
+    private:
+        static uint64_t payloadBytes() { return PreflopTable::payloadBytes(); }
+
+        // ֻǣԽߣȡ 1 - Գÿʹö
+        static void buildHeadsUp(const Options& options, float* headsUp) {
+            const int n = StartingHands::COUNT;
+            std::vector<std::vector<CardSet>> combos(n);
+            for (int cls = 0; cls < n; ++cls) combos[cls] = StartingHands::combos(cls);
+
+            std::vector<std::pair<int, int>> pairs;
+            for (int a = 0; a < n; ++a) {
+                for (int b = a; b < n; ++b) pairs.emplace_back(a, b);
+            }
+
+            unsigned threadCount = options.threads ? options.threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+            std::atomic<size_t> next{ 0 };
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&]() {
+                    for (size_t i = next++; i < pairs.size(); i = next++) {
+                        int a = pairs[i].first, b = pairs[i].second;
+                        Xoshiro256 rng(options.seed, i);
+                        double e = headsUpEquity(combos[a], combos[b], options.trials, rng);
+                        headsUp[a * n + b] = static_cast<float>(e);
+                        headsUp[b * n + a] = static_cast<float>(1.0 - e);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+        }
+
+        static double headsUpEquity(const std::vector<CardSet>& heroCombos,
+            const std::vector<CardSet>& villainCombos, uint64_t trials, Xoshiro256& rng) {
+            double share = 0;
+            for (uint64_t t = 0; t < trials; ++t) {
+                CardSet hero, villain;
+                do {
+                    hero = heroCombos[rng.bounded(static_cast<uint32_t>(heroCombos.size()))];
+                    villain = villainCombos[rng.bounded(static_cast<uint32_t>(villainCombos.size()))];
+                } while (!(hero & villain).empty());
+
+                Deck deck(CardSet::fullDeck() - hero - villain);
+                CardSet board = deck.dealRandomSet(rng, 5);
+                uint32_t h = FastEvaluator::score(hero | board);
+                uint32_t v = FastEvaluator::score(villain | board);
+                share += h > v ? 1.0 : (h == v ? 0.5 : 0.0);
+            }
+            return trials ? share / trials : 0.5;
+        }
+    };
+
+}
+
+#endif
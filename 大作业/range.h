@@ -0,0 +1,212 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "starting_hands.h"
+
+namespace rules {
+
+    struct WeightedCombo {
+        CardSet cards;       // ŵ
+        double weight = 1.0; // ڷΧеȨأ0-1
+    };
+
+    // ƷΧȨصľбÿֻһ
+    //  "QQ+, AKs, A5s-A2s, KQo, AhKh, JTs:0.5" дðźΪȨ
+    class Range {
+    public:
+        Range() = default;
+
+        static Range parse(const std::string& text) {
+            Range range;
+            size_t start = 0;
+            while (start <= text.size()) {
+                size_t end = text.find(',', start);
+                if (end == std::string::npos) end = text.size();
+                std::string token = trim(text.substr(start, end - start));
+                if (!token.empty()) range.addToken(token);
+                start = end + 1;
+            }
+            return range;
+        }
+
+        static Range of(CardSet hand, double weight = 1.0) {
+            Range range;
+            range.add(hand, weight);
+            return range;
+        }
+
+        static Range of(const HoleCards& hand) {
+            return of(hand.getCardSet());
+        }
+
+        // һϣѴʱȨأȨΪ0ϲ
+        void add(CardSet combo, double weight = 1.0) {
+            if (combo.size() != 2) throw std::invalid_argument("Range combo must be two cards");
+            if (weight < 0 || weight > 1) throw std::invalid_argument("Range weight must be in [0, 1]");
+            auto it = index_.find(combo.bits());
+            if (it != index_.end()) {
+                combos_[it->second].weight = weight;
+                return;
+            }
+            if (weight == 0) return;
+            index_[combo.bits()] = combos_.size();
+            combos_.push_back({ combo, weight });
+        }
+
+        // ȥƣơ֪Ƶȣͻ
+        Range without(CardSet dead) const {
+            Range range;
+            for (const auto& c : combos_) {
+                if ((c.cards & dead).empty() && c.weight > 0) range.add(c.cards, c.weight);
+            }
+            return range;
+        }
+
+        const std::vector<WeightedCombo>& combos() const { return combos_; }
+        size_t size() const { return combos_.size(); }
+        bool empty() const { return combos_.empty(); }
+
+        double totalWeight() const {
+            double total = 0;
+            for (const auto& c : combos_) total += c.weight;
+            return total;
+        }
+
+    private:
+        std::vector<WeightedCombo> combos_;
+        std::unordered_map<uint64_t, size_t> index_;
+
+        static std::string trim(const std::string& s) {
+            size_t b = 0, e = s.size();
+            while (b < e && std::isspace(static_cast<unsigned char>(s[b]))) b++;
+            while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1]))) e--;
+            return s.substr(b, e - b);
+        }
+
+        // ַת rankIndexTwo=0 ... Ace=12Ч -1
+        static int parseRank(char c) {
+            static const char RANKS[] = "23456789TJQKA";
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            for (int i = 0; i < 13; ++i) {
+                if (RANKS[i] == c) return i;
+            }
+            return -1;
+        }
+
+        static int parseSuit(char c) {
+            switch (std::tolower(static_cast<unsigned char>(c))) {
+            case 'h': return static_cast<int>(Suit::Hearts);
+            case 'd': return static_cast<int>(Suit::Diamonds);
+            case 'c': return static_cast<int>(Suit::Clubs);
+            case 's': return static_cast<int>(Suit::Spades);
+            default:  return -1;
+            }
+        }
+
+        // һƣ"AK""AKs""AKo""QQ"suitedness's''o'  0Ҫ
+        struct HandClass {
+            int high = -1, low = -1;
+            char suitedness = 0;
+        };
+
+        static bool parseClass(const std::string& s, HandClass& hc) {
+            if (s.size() < 2 || s.size() > 3) return false;
+            hc.high = parseRank(s[0]);
+            hc.low = parseRank(s[1]);
+            if (hc.high < 0 || hc.low < 0) return false;
+            if (hc.high < hc.low) std::swap(hc.high, hc.low);
+            hc.suitedness = 0;
+            if (s.size() == 3) {
+                char c = static_cast<char>(std::tolower(static_cast<unsigned char>(s[2])));
+                if ((c != 's' && c != 'o') || hc.high == hc.low) return false;
+                hc.suitedness = c;
+            }
+            return true;
+        }
+
+        void addClass(int high, int low, char suitedness, double weight) {
+            if (high == low || suitedness != 'o') addCombos(StartingHands::classIndex(high, low, true), weight);
+            if (high != low && suitedness != 's') addCombos(StartingHands::classIndex(high, low, false), weight);
+        }
+
+        void addCombos(int cls, double weight) {
+            for (CardSet combo : StartingHands::combos(cls)) add(combo, weight);
+        }
+
+        void addToken(const std::string& raw) {
+            std::string token = raw;
+            double weight = 1.0;
+            size_t colon = token.find(':');
+            if (colon != std::string::npos) {
+                std::string w = trim(token.substr(colon + 1));
+                char* end = nullptr;
+                weight = std::strtod(w.c_str(), &end);
+                if (w.empty() || *end != '\0' || weight < 0 || weight > 1) {
+                    throw std::invalid_argument("Invalid weight in range token: " + raw);
+                }
+                token = trim(token.substr(0, colon));
+            }
+
+            // ϣ AhKd
+            if (token.size() == 4 && parseRank(token[0]) >= 0 && parseSuit(token[1]) >= 0 &&
+                parseRank(token[2]) >= 0 && parseSuit(token[3]) >= 0) {
+                CardSet combo;
+                combo.add(Card(static_cast<Suit>(parseSuit(token[1])), rankFromIndex(parseRank(token[0]))));
+                combo.add(Card(static_cast<Suit>(parseSuit(token[3])), rankFromIndex(parseRank(token[2]))));
+                if (combo.size() != 2) throw std::invalid_argument("Duplicate card in range token: " + raw);
+                add(combo, weight);
+                return;
+            }
+
+            bool plus = !token.empty() && token.back() == '+';
+            if (plus) token.pop_back();
+            size_t dash = token.find('-');
+
+            HandClass from;
+            if (!parseClass(dash == std::string::npos ? token : token.substr(0, dash), from)) {
+                throw std::invalid_argument("Invalid range token: " + raw);
+            }
+
+            if (dash != std::string::npos) {
+                // QQ-88  A5s-A2sͬһƣǶӣ֮
+                HandClass to;
+                if (plus || !parseClass(token.substr(dash + 1), to) || to.suitedness != from.suitedness) {
+                    throw std::invalid_argument("Invalid range token: " + raw);
+                }
+                bool pairs = from.high == from.low && to.high == to.low;
+                if (!pairs && (from.high != to.high || from.high == from.low || to.high == to.low)) {
+                    throw std::invalid_argument("Invalid range token: " + raw);
+                }
+                int lo = pairs ? std::min(from.high, to.high) : std::min(from.low, to.low);
+                int hi = pairs ? std::max(from.high, to.high) : std::max(from.low, to.low);
+                for (int r = lo; r <= hi; ++r) {
+                    if (pairs) addClass(r, r, 0, weight);
+                    else addClass(from.high, r, from.suitedness, weight);
+                }
+            }
+            else if (plus) {
+                // QQ+  AAATs+ ߽ȸСһ
+                if (from.high == from.low) {
+                    for (int r = from.high; r < 13; ++r) addClass(r, r, 0, weight);
+                }
+                else {
+                    for (int r = from.low; r < from.high; ++r) addClass(from.high, r, from.suitedness, weight);
+                }
+            }
+            else {
+                addClass(from.high, from.low, from.suitedness, weight);
+            }
+        }
+    };
+
+}
+
+#endif
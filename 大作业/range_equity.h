@@ -0,0 +1,304 @@
+#ifndef RANGE_EQUITY_H
+#define RANGE_EQUITY_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include "poker.h"
+#include "rng.h"
+#include "fast_evaluator.h"
+#include "equity.h"
+#include "range.h"
+
+namespace rules {
+
+    struct RangeEquityOptions {
+        enum class Method { Auto, Exact, MonteCarlo };
+
+        Method method = Method::Auto;
+        double exactLimit = 2e7;      // Auto ʱƵ̯ƴֵ;ȷö
+        uint64_t maxTrials = 200000;  // ؿģ
+        unsigned threads = 0;         // 0 ʾʹȫ
+        uint64_t seed = 0;            // 0 ʾ
+    };
+
+    struct RangeEquityResult {
+        std::vector<PlayerEquity> players;  // Ȩƽ ranges ˳ͬ
+        bool exact = false;
+        uint64_t showdowns = 0;             // ȷöٵ̯ģ
+        double elapsedMs = 0;
+    };
+
+    // ΧԷΧԾƣʤʣ2-10
+    // ȥ빫ơƳͻϣٰƿѡȷöٻؿ壻
+    // ֮λжǷͻһλҵϷָ߳
+    class RangeEquity {
+    public:
+        static RangeEquityResult run(
+            const std::vector<Range>& ranges,
+            const std::vector<Card>& communityCards,
+            CardSet dead = CardSet(),
+            const RangeEquityOptions& options = RangeEquityOptions()
+        ) {
+            auto start = std::chrono::steady_clock::now();
+            Setup setup = prepare(ranges, communityCards, dead);
+
+            bool exact = options.method == RangeEquityOptions::Method::Exact ||
+                (options.method == RangeEquityOptions::Method::Auto && exactCost(setup) <= options.exactLimit);
+            unsigned threadCount = options.threads ? options.threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+
+            RangeEquityResult result = exact
+                ? enumerateAll(setup, threadCount)
+                : simulate(setup, options, threadCount);
+            result.exact = exact;
+            result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        // ȷöҪ̯ƴͻƣϽ磩
+        static double exactCost(const std::vector<Range>& ranges, const std::vector<Card>& communityCards,
+            CardSet dead = CardSet()) {
+            return exactCost(prepare(ranges, communityCards, dead));
+        }
+
+    private:
+        static const int MAX_PLAYERS = 10;
+        static const uint64_t BATCH = 1024;
+        static const int MAX_REJECTIONS = 10000;
+
+        struct Setup {
+            std::vector<Range> ranges;          // ȥ赲
+            std::vector<std::vector<double>> cumulative;  // ΧۼȨأڰȨس
+            CardSet board;
+            CardSet live;                       // ƺ
+            int players = 0;
+            int toDeal = 0;
+        };
+
+        struct Tally {
+            std::vector<double> win, tie, share, shareSq;
+            double total = 0;                   // ȨܺͣģʱΪ
+            uint64_t showdowns = 0;
+
+            explicit Tally(int players) : win(players), tie(players), share(players), shareSq(players) {}
+
+            void merge(const Tally& o) {
+                for (size_t p = 0; p < win.size(); ++p) {
+                    win[p] += o.win[p];
+                    tie[p] += o.tie[p];
+                    share[p] += o.share[p];
+                    shareSq[p] += o.shareSq[p];
+                }
+                total += o.total;
+                showdowns += o.showdowns;
+            }
+
+            // һ̯ƣweight ΪϴȨ
+            void settle(const CardSet* hands, int players, CardSet board, double weight) {
+                uint32_t scores[MAX_PLAYERS];
+                uint32_t best = 0;
+                int winners = 0;
+                for (int p = 0; p < players; ++p) {
+                    scores[p] = FastEvaluator::score(hands[p] | board);
+                    if (scores[p] > best) { best = scores[p]; winners = 1; }
+                    else if (scores[p] == best) winners++;
+                }
+                double part = 1.0 / winners;
+                for (int p = 0; p < players; ++p) {
+                    if (scores[p] != best) continue;
+                    if (winners == 1) win[p] += weight;
+                    else tie[p] += weight;
+                    share[p] += weight * part;
+                    shareSq[p] += weight * part * part;
+                }
+                total += weight;
+                showdowns++;
+            }
+
+            RangeEquityResult toResult(bool sampled) const {
+                if (total <= 0) throw std::invalid_argument("Ranges leave no compatible combinations");
+                RangeEquityResult result;
+                result.showdowns = showdowns;
+                for (size_t p = 0; p < win.size(); ++p) {
+                    PlayerEquity e;
+                    e.win = win[p] / total;
+                    e.tie = tie[p] / total;
+                    e.lose = 1.0 - e.win - e.tie;
+                    e.equity = share[p] / total;
+                    if (sampled && total > 1) {
+                        double var = (shareSq[p] / total - e.equity * e.equity) * total / (total - 1);
+                        e.stdError = std::sqrt(std::max(var, 0.0) / total);
+                    }
+                    e.ciLow = std::max(0.0, e.equity - 1.96 * e.stdError);
+                    e.ciHigh = std::min(1.0, e.equity + 1.96 * e.stdError);
+                    result.players.push_back(e);
+                }
+                return result;
+            }
+        };
+
+        static Setup prepare(const std::vector<Range>& ranges, const std::vector<Card>& communityCards, CardSet dead) {
+            if (ranges.size() < 2 || ranges.size() > MAX_PLAYERS) {
+                throw std::invalid_argument("Range equity needs 2 to 10 players");
+            }
+            if (communityCards.size() > 5) throw std::invalid_argument("Too many community cards");
+
+            Setup setup;
+            setup.board = CardSet::of(communityCards);
+            if (setup.board.size() != static_cast<int>(communityCards.size()) || !(setup.board & dead).empty()) {
+                throw std::invalid_argument("Duplicate card on board");
+            }
+            CardSet blocked = setup.board | dead;
+            setup.live = CardSet::fullDeck() - blocked;
+            setup.players = static_cast<int>(ranges.size());
+            setup.toDeal = 5 - static_cast<int>(communityCards.size());
+            for (const Range& range : ranges) {
+                Range open = range.without(blocked);
+                if (open.empty()) throw std::invalid_argument("Range is empty after removing blocked combos");
+                std::vector<double> cumulative;
+                double sum = 0;
+                for (const auto& c : open.combos()) cumulative.push_back(sum += c.weight);
+                setup.cumulative.push_back(cumulative);
+                setup.ranges.push_back(open);
+            }
+            return setup;
+        }
+
+        static double exactCost(const Setup& setup) {
+            double tuples = 1;
+            for (const Range& r : setup.ranges) tuples *= static_cast<double>(r.size());
+            double runouts = 1;
+            int live = setup.live.size() - 2 * setup.players;
+            for (int k = 0; k < setup.toDeal; ++k) runouts = runouts * (live - k) / (k + 1);
+            return tuples * runouts;
+        }
+
+        // ---- ȷö ----
+
+        static RangeEquityResult enumerateAll(const Setup& setup, unsigned threadCount) {
+            const auto& first = setup.ranges[0].combos();
+            threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(first.size()));
+            std::atomic<size_t> next{ 0 };
+            std::vector<Tally> tallies(threadCount, Tally(setup.players));
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    CardSet hands[MAX_PLAYERS];
+                    for (size_t i = next++; i < first.size(); i = next++) {
+                        hands[0] = first[i].cards;
+                        chooseCombos(setup, 1, hands, first[i].cards, first[i].weight, tallies[t]);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+
+            Tally total(setup.players);
+            for (const auto& tally : tallies) total.merge(tally);
+            return total.toResult(false);
+        }
+
+        // ΪÿλѡѡƲͻ
+        static void chooseCombos(const Setup& setup, int player, CardSet* hands, CardSet used,
+            double weight, Tally& tally) {
+            if (player == setup.players) {
+                std::vector<Card> live = (setup.live - used).toCards();
+                dealRunouts(setup, hands, live, 0, setup.toDeal, setup.board, weight, tally);
+                return;
+            }
+            for (const auto& c : setup.ranges[player].combos()) {
+                if (!(c.cards & used).empty()) continue;
+                hands[player] = c.cards;
+                chooseCombos(setup, player + 1, hands, used | c.cards, weight * c.weight, tally);
+            }
+        }
+
+        static void dealRunouts(const Setup& setup, const CardSet* hands, const std::vector<Card>& live,
+            size_t from, int left, CardSet board, double weight, Tally& tally) {
+            if (left == 0) {
+                tally.settle(hands, setup.players, board, weight);
+                return;
+            }
+            for (size_t i = from; i + left <= live.size(); ++i) {
+                CardSet next = board;
+                next.add(live[i]);
+                dealRunouts(setup, hands, live, i + 1, left - 1, next, weight, tally);
+            }
+        }
+
+        // ---- ؿ ----
+
+        static RangeEquityResult simulate(const Setup& setup, const RangeEquityOptions& options, unsigned threadCount) {
+            if (options.maxTrials == 0) throw std::invalid_argument("No trials for range equity simulation");
+            uint64_t seed = options.seed ? options.seed : randomSeed();
+            uint64_t batches = (options.maxTrials + BATCH - 1) / BATCH;
+            threadCount = static_cast<unsigned>(std::min<uint64_t>(threadCount, batches));
+
+            std::atomic<uint64_t> next{ 0 };
+            std::vector<Tally> tallies(threadCount, Tally(setup.players));
+            // ߳쳣緶Χ֮鲻ͻϣݳ̣߳
+            // µһ߳ͣ£join ֮׸
+            std::vector<std::exception_ptr> errors(threadCount);
+            std::atomic<bool> failed{ false };
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    try {
+                        CardSet hands[MAX_PLAYERS];
+                        for (uint64_t b = next++; b < batches && !failed.load(std::memory_order_relaxed); b = next++) {
+                            // ÿֻӺž߳޹
+                            Xoshiro256 rng(seed, b);
+                            uint64_t n = std::min<uint64_t>(BATCH, options.maxTrials - b * BATCH);
+                            for (uint64_t i = 0; i < n; ++i) {
+                                CardSet used = sampleCombos(setup, rng, hands);
+                                Deck deck(setup.live - used);
+                                CardSet board = setup.board | deck.dealRandomSet(rng, setup.toDeal);
+                                tallies[t].settle(hands, setup.players, board, 1.0);
+                            }
+                        }
+                    }
+                    catch (...) {
+                        errors[t] = std::current_exception();
+                        failed = true;
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+            for (const auto& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+
+            Tally total(setup.players);
+            for (const auto& tally : tallies) total.merge(tally);
+            return total.toResult(true);
+        }
+
+        // ȨΪÿλҳһϣгͻس飨֤Ȩس˻Ϸֲ
+        static CardSet sampleCombos(const Setup& setup, Xoshiro256& rng, CardSet* hands) {
+            for (int attempt = 0; attempt < MAX_REJECTIONS; ++attempt) {
+                CardSet used;
+                int p = 0;
+                for (; p < setup.players; ++p) {
+                    const std::vector<double>& cumulative = setup.cumulative[p];
+                    double x = (rng() >> 11) * (1.0 / 9007199254740992.0) * cumulative.back();
+                    size_t i = std::upper_bound(cumulative.begin(), cumulative.end(), x) - cumulative.begin();
+                    if (i == cumulative.size()) i--;
+                    CardSet combo = setup.ranges[p].combos()[i].cards;
+                    if (!(combo & used).empty()) break;
+                    hands[p] = combo;
+                    used |= combo;
+                }
+                if (p == setup.players) return used;
+            }
+            throw std::invalid_argument("Ranges leave no compatible combinations");
+        }
+    };
+
+}
+
+#endif
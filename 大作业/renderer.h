@@ -0,0 +1,231 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+// ͼο޹صĻƽӿڣμͰػ
+namespace render {
+
+    // ɫ EasyX  COLORREF ͬ0x00BBGGRR
+    typedef uint32_t Color;
+
+    inline Color rgb(int r, int g, int b) {
+        return static_cast<Color>(r | (g << 8) | (b << 16));
+    }
+
+    // Ͻǰ½ǲľ
+    struct Rect {
+        int left = 0, top = 0, right = 0, bottom = 0;
+
+        Rect() = default;
+        Rect(int l, int t, int r, int b) : left(l), top(t), right(r), bottom(b) {}
+
+        static Rect sized(int x, int y, int w, int h) { return Rect(x, y, x + w, y + h); }
+
+        int width() const { return right - left; }
+        int height() const { return bottom - top; }
+        bool empty() const { return right <= left || bottom <= top; }
+
+        bool intersects(const Rect& o) const {
+            return left < o.right && o.left < right && top < o.bottom && o.top < bottom;
+        }
+
+        Rect united(const Rect& o) const {
+            if (empty()) return o;
+            if (o.empty()) return *this;
+            return Rect(std::min(left, o.left), std::min(top, o.top), std::max(right, o.right), std::max(bottom, o.bottom));
+        }
+
+        Rect intersected(const Rect& o) const {
+            Rect r(std::max(left, o.left), std::max(top, o.top), std::min(right, o.right), std::min(bottom, o.bottom));
+            return r.empty() ? Rect() : r;
+        }
+
+        bool operator==(const Rect& o) const {
+            return left == o.left && top == o.top && right == o.right && bottom == o.bottom;
+        }
+        bool operator!=(const Rect& o) const { return !(*this == o); }
+    };
+
+    // ͼӱż Card::index()ɫ*16+ ɫ x  У
+    // ƱòӦκƵı15ڵ5е1
+    struct AtlasLayout {
+        static const int COLUMNS = 13;
+        static const int ROWS = 5;
+        static const int CARD_BACK = 15;
+
+        static bool validSlot(int slot) {
+            return slot == CARD_BACK || (slot >= 0 && slot < 64 && slot % 16 < COLUMNS);
+        }
+
+        static Rect slotRect(int slot, int cardWidth, int cardHeight) {
+            int column = slot == CARD_BACK ? 0 : slot % 16;
+            int row = slot == CARD_BACK ? 4 : slot / 16;
+            return Rect::sized(column * cardWidth, row * cardHeight, cardWidth, cardHeight);
+        }
+    };
+
+    // ˽ӿڣлƶ setClip õ
+    class Renderer {
+    public:
+        virtual ~Renderer() {}
+
+        virtual int width() const = 0;
+        virtual int height() const = 0;
+
+        virtual void setClip(const Rect& clip) = 0;
+        virtual void drawBackground() = 0;
+        virtual void drawSprite(int slot, int x, int y) = 0;
+        virtual void fillRoundRect(const Rect& rect, Color color) = 0;
+        virtual void drawText(int x, int y, const std::wstring& text, Color color) = 0;
+
+        // ѱ֡ػʾ
+        virtual void present(const std::vector<Rect>& dirty) = 0;
+    };
+
+    // еһԪأid ֮֡䱣ֲ䣬Ƚǰ֡
+    struct Item {
+        enum class Kind : uint8_t { Sprite, Button, Text };
+
+        int id = 0;
+        Kind kind = Kind::Sprite;
+        Rect rect;            // ԪռݵΪʾ
+        int slot = 0;         // Spriteͼ
+        Color color = 0;      // ButtonɫTextɫ
+        std::wstring text;
+
+        static Item sprite(int id, int slot, int x, int y, int w, int h) {
+            Item item;
+            item.id = id;
+            item.kind = Kind::Sprite;
+            item.slot = slot;
+            item.rect = Rect::sized(x, y, w, h);
+            return item;
+        }
+
+        static Item button(int id, const Rect& rect, Color color) {
+            Item item;
+            item.id = id;
+            item.kind = Kind::Button;
+            item.rect = rect;
+            item.color = color;
+            return item;
+        }
+
+        static Item label(int id, const Rect& rect, const std::wstring& text, Color color) {
+            Item item;
+            item.id = id;
+            item.kind = Kind::Text;
+            item.rect = rect;
+            item.text = text;
+            item.color = color;
+            return item;
+        }
+
+        bool operator==(const Item& o) const {
+            return id == o.id && kind == o.kind && rect == o.rect && slot == o.slot &&
+                color == o.color && text == o.text;
+        }
+        bool operator!=(const Item& o) const { return !(*this == o); }
+    };
+
+    // һ֡Ҫʾݣ˳ϻƣ²
+    struct Scene {
+        std::vector<Item> items;
+
+        void add(const Item& item) { items.push_back(item); }
+    };
+
+    // סһ֡ĳֻػ淢仯򣻳ûʱú
+    class Compositor {
+    public:
+        // ر֡ػ
+        std::vector<Rect> render(Renderer& renderer, const Scene& scene) {
+            // ֡һ֡ȫֱͬӷأڴ
+            if (!full_ && scene.items == previous_.items) return std::vector<Rect>();
+
+            std::vector<Rect> dirty = full_
+                ? std::vector<Rect>{ Rect(0, 0, renderer.width(), renderer.height()) }
+                : diff(scene);
+            full_ = false;
+            previous_ = scene;
+            if (dirty.empty()) return dirty;
+
+            for (const Rect& area : dirty) {
+                renderer.setClip(area);
+                renderer.drawBackground();
+                for (const Item& item : scene.items) {
+                    if (item.rect.intersects(area)) draw(renderer, item);
+                }
+            }
+            renderer.setClip(Rect(0, 0, renderer.width(), renderer.height()));
+            renderer.present(dirty);
+            return dirty;
+        }
+
+        // һ֡ػ棨ڱǡл˵ȣ
+        void invalidate() { full_ = true; }
+
+    private:
+        Scene previous_;
+        bool full_ = true;
+
+        // ¾֡ݲͬԪأ¾λöҪػ
+        std::vector<Rect> diff(const Scene& scene) const {
+            std::unordered_map<int, const Item*> old;
+            for (const Item& item : previous_.items) old[item.id] = &item;
+
+            std::vector<Rect> dirty;
+            for (const Item& item : scene.items) {
+                auto it = old.find(item.id);
+                if (it == old.end()) {
+                    dirty.push_back(item.rect);
+                    continue;
+                }
+                if (*it->second != item) {
+                    dirty.push_back(it->second->rect);
+                    dirty.push_back(item.rect);
+                }
+                old.erase(it);
+            }
+            for (const auto& removed : old) dirty.push_back(removed.second->rect);
+            return merge(dirty);
+        }
+
+        // ϲཻľΣͬһظ
+        static std::vector<Rect> merge(std::vector<Rect> rects) {
+            rects.erase(std::remove_if(rects.begin(), rects.end(),
+                [](const Rect& r) { return r.empty(); }), rects.end());
+            bool merged = true;
+            while (merged) {
+                merged = false;
+                for (size_t i = 0; i < rects.size() && !merged; ++i) {
+                    for (size_t j = i + 1; j < rects.size(); ++j) {
+                        if (rects[i].intersects(rects[j])) {
+                            rects[i] = rects[i].united(rects[j]);
+                            rects.erase(rects.begin() + j);
+                            merged = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            return rects;
+        }
+
+        static void draw(Renderer& renderer, const Item& item) {
+            switch (item.kind) {
+            case Item::Kind::Sprite: renderer.drawSprite(item.slot, item.rect.left, item.rect.top); break;
+            case Item::Kind::Button: renderer.fillRoundRect(item.rect, item.color); break;
+            case Item::Kind::Text:   renderer.drawText(item.rect.left, item.rect.top, item.text, item.color); break;
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef POKER_RNG_H
+#define POKER_RNG_H
+
+#include <cstdint>
+#include <random>
+
+namespace Poker {
+
+    // splitmix64ڰһչɷ״̬
+    inline uint64_t splitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256** С״̬32ֽ״̬ UniformRandomBitGenerator
+    // ֱ std::shuffle ͸ֲַ
+    class Xoshiro256 {
+    public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+        // ͬһµĵ stream Уڶ̻߳ģ⣩
+        Xoshiro256(uint64_t seed, uint64_t stream) {
+            this->seed(seed ^ (stream * 0xD1B54A32D192ED03ULL + 0x8CB92BA72F3D8DD7ULL));
+        }
+
+        void seed(uint64_t seed) {
+            uint64_t sm = seed;
+            for (auto& word : s_) word = splitMix64(sm);
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+
+        result_type operator()() {
+            uint64_t result = rotl(s_[1] * 5, 7) * 9;
+            uint64_t t = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+            return result;
+        }
+
+        // [0, n) ڵ˷ȡλ
+        uint32_t bounded(uint32_t n) {
+            return static_cast<uint32_t>(((operator()() >> 32) * n) >> 32);
+        }
+
+        // ǰ 2^128 õԭвص
+        void jump() {
+            static const uint64_t JUMP[] = {
+                0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+            };
+            uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            for (uint64_t word : JUMP) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (1ULL << b)) {
+                        s0 ^= s_[0];
+                        s1 ^= s_[1];
+                        s2 ^= s_[2];
+                        s3 ^= s_[3];
+                    }
+                    operator()();
+                }
+            }
+            s_[0] = s0;
+            s_[1] = s1;
+            s_[2] = s2;
+            s_[3] = s3;
+        }
+
+    private:
+        uint64_t s_[4];
+
+        static uint64_t rotl(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+
+    //  random_device һӣֻҪȷԽʱã
+    inline uint64_t randomSeed() {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }
+
+    // ̵߳ĬϷһʹʱһ
+    inline Xoshiro256& threadRng() {
+        thread_local Xoshiro256 rng(randomSeed());
+        return rng;
+    }
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef SHOWDOWN_H
+#define SHOWDOWN_H
+
+#include <cstdint>
+#include <stdexcept>
+#include "poker.h"
+#include "fast_evaluator.h"
+
+namespace rules {
+
+    // һ̯Ƶɵ÷ṩ洢ͨջϣ
+    // ҰӴСֲ㣬ͬͬһ㣬λʾ
+    struct ShowdownResult {
+        static const int MAX_PLAYERS = 10;
+
+        uint32_t score[MAX_PLAYERS];   // ҵFastEvaluator::scoreδΪ 0
+        uint16_t tier[MAX_PLAYERS];    // tier[0] Ϊǿһ
+        uint8_t tierOf[MAX_PLAYERS];   // ڵĲ㣬δΪ tiers
+        int players = 0;
+        int tiers = 0;
+
+        uint16_t winners() const { return tiers ? tier[0] : 0; }
+
+        // eligible ңֱ߳ʱÿظȡһΣ
+        uint16_t best(uint16_t eligible) const {
+            for (int t = 0; t < tiers; ++t) {
+                if (tier[t] & eligible) return tier[t] & eligible;
+            }
+            return 0;
+        }
+    };
+
+    // ̶ N ̯ƣֻͳһΣÿֻټŵƣκζѷ
+    class Showdown {
+    public:
+        static const int MAX_PLAYERS = ShowdownResult::MAX_PLAYERS;
+        static const uint16_t ALL = (1u << MAX_PLAYERS) - 1;
+
+        // hands[0..count)  board ̯ƣֻ active еҲ루ƵĲ룩
+        static void rank(const CardSet* hands, int count, CardSet board, ShowdownResult& out, uint16_t active = ALL) {
+            if (count < 0 || count > MAX_PLAYERS) throw std::invalid_argument("Showdown supports at most 10 hands");
+            FastEvaluator::Accumulator base = boardAccumulator(board);
+
+            // ߰ӴС 10 ˣ
+            int order[MAX_PLAYERS];
+            int n = 0;
+            out.players = count;
+            for (int p = 0; p < count; ++p) {
+                out.score[p] = 0;
+                if (!((active >> p) & 1)) continue;
+                uint32_t s = score(base, hands[p]);
+                out.score[p] = s;
+                int k = n++;
+                for (; k > 0 && out.score[order[k - 1]] < s; --k) order[k] = order[k - 1];
+                order[k] = p;
+            }
+
+            out.tiers = 0;
+            for (int i = 0; i < n; ++i) {
+                int p = order[i];
+                if (i == 0 || out.score[p] != out.score[order[i - 1]]) out.tier[out.tiers++] = 0;
+                out.tier[out.tiers - 1] |= static_cast<uint16_t>(1u << p);
+                out.tierOf[p] = static_cast<uint8_t>(out.tiers - 1);
+            }
+            for (int p = 0; p < count; ++p) {
+                if (!((active >> p) & 1)) out.tierOf[p] = static_cast<uint8_t>(out.tiers);
+            }
+        }
+
+        // ֻҪӮʱ򣺷룬scores Ϊ
+        static uint16_t winners(const CardSet* hands, int count, CardSet board, uint32_t* scores = nullptr,
+            uint16_t active = ALL) {
+            if (count < 0 || count > MAX_PLAYERS) throw std::invalid_argument("Showdown supports at most 10 hands");
+            FastEvaluator::Accumulator base = boardAccumulator(board);
+            uint32_t best = 0;
+            uint16_t mask = 0;
+            for (int p = 0; p < count; ++p) {
+                uint32_t s = (active >> p) & 1 ? score(base, hands[p]) : 0;
+                if (scores) scores[p] = s;
+                if (!((active >> p) & 1)) continue;
+                if (!mask || s > best) { best = s; mask = 0; }
+                if (s == best) mask |= static_cast<uint16_t>(1u << p);
+            }
+            return mask;
+        }
+
+    private:
+        static FastEvaluator::Accumulator boardAccumulator(CardSet board) {
+            FastEvaluator::Accumulator acc;
+            for (CardSet rest = board; !rest.empty();) acc.add(rest.popFirst());
+            return acc;
+        }
+
+        static uint32_t score(const FastEvaluator::Accumulator& base, CardSet hand) {
+            FastEvaluator::Accumulator acc = base;
+            for (CardSet rest = hand; !rest.empty();) acc.add(rest.popFirst());
+            return FastEvaluator::score(acc);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+#include "rng.h"
+#include "fast_evaluator.h"
+#include "game_engine.h"
+#include "cfr.h"
+
+// ģ⣺ܶŻصɹȡ̳߳صȣÿԼ
+namespace sim {
+
+    using engine::HandState;
+    using engine::GameEngine;
+    using engine::Action;
+
+    // ˲ԣact ̰߳ȫģ޸״̬
+    class BotPolicy {
+    public:
+        virtual ~BotPolicy() = default;
+        virtual std::string name() const = 0;
+        virtual Action act(const HandState& s, Xoshiro256& rng) const = 0;
+    };
+
+    // ֻƻע
+    class CallingStation : public BotPolicy {
+    public:
+        std::string name() const override { return "calling-station"; }
+        Action act(const HandState& s, Xoshiro256&) const override {
+            return GameEngine::legalActions(s).canCheck ? Action::check() : Action::call();
+        }
+    };
+
+    // ԭͼνĵԣ80% ע20% Сע
+    class LooseRandom : public BotPolicy {
+    public:
+        std::string name() const override { return "loose-random"; }
+        Action act(const HandState& s, Xoshiro256& rng) const override {
+            engine::LegalActions legal = GameEngine::legalActions(s);
+            if (rng.bounded(10) < 8 || !legal.canRaise) return legal.canCheck ? Action::check() : Action::call();
+            return Action::raiseTo(legal.minRaiseTo);
+        }
+    };
+
+    // ףǰֻƣƺ󰴳ƴСע
+    class TightAggressive : public BotPolicy {
+    public:
+        std::string name() const override { return "tight-aggressive"; }
+        Action act(const HandState& s, Xoshiro256&) const override {
+            engine::LegalActions legal = GameEngine::legalActions(s);
+            const engine::SeatState& me = s.seat[s.toAct];
+            int strength;
+            if (s.boardCount == 0) {
+                CardSet h = me.hole;
+                Card a = h.popFirst(), b = h.popFirst();
+                int hi = std::max(rankIndex(a.rank()), rankIndex(b.rank()));
+                int lo = std::min(rankIndex(a.rank()), rankIndex(b.rank()));
+                // 2 99+  J ϣ1ӡͬ A ƣ0
+                strength = (hi == lo && hi >= 7) || lo >= 9 ? 2 : (hi == lo || a.suit() == b.suit() || hi == 12 ? 1 : 0);
+            }
+            else {
+                int category = static_cast<int>(rules::HandStrength(rules::FastEvaluator::score(me.hole | s.boardSet())).rank());
+                strength = category >= 2 ? 2 : category;
+            }
+            if (strength == 2 && legal.canRaise) {
+                int32_t target = s.currentBet + std::max(s.pot(), legal.minRaiseTo - s.currentBet);
+                return Action::raiseTo(std::max(legal.minRaiseTo, std::min(target, legal.maxRaiseTo)));
+            }
+            if (legal.canCheck) return Action::check();
+            if (strength >= 1 && legal.callAmount * 4 <= s.pot()) return Action::call();
+            return strength == 2 ? Action::call() : Action::fold();
+        }
+    };
+
+    //  CFR ļжֻ
+    class CfrBot : public BotPolicy {
+    public:
+        explicit CfrBot(const ai::CfrStrategy& strategy) : strategy_(strategy) {}
+        std::string name() const override { return "cfr"; }
+        Action act(const HandState& s, Xoshiro256& rng) const override { return strategy_.choose(s, rng); }
+
+    private:
+        const ai::CfrStrategy& strategy_;
+    };
+
+    // ȡȣÿ߳Լ˫˶УԼβȡȳ
+    // ʱһ̴߳ͷ͵һһʱ԰ѺŻԼĶС
+    // ģ run 
+    class WorkStealingScheduler {
+    public:
+        using Handler = std::function<void(unsigned worker, uint32_t item)>;
+
+        explicit WorkStealingScheduler(unsigned threads) : queues_(threads ? threads : 1) {}
+
+        //  items ָ̺߳ʼȫ
+        void run(const std::vector<uint32_t>& items, const Handler& handler) {
+            for (size_t i = 0; i < items.size(); ++i) queues_[i % queues_.size()].items.push_back(items[i]);
+            pending_ = items.size();
+            steals_ = 0;
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < queues_.size(); ++t) {
+                workers.emplace_back([this, t, &handler]() { work(t, handler); });
+            }
+            for (auto& w : workers) w.join();
+        }
+
+        // ֻ handler еãѺŽǰ̵߳Ķ
+        void push(unsigned worker, uint32_t item) {
+            pending_++;
+            Queue& q = queues_[worker];
+            std::lock_guard<std::mutex> guard(q.lock);
+            q.items.push_back(item);
+        }
+
+        unsigned threads() const { return static_cast<unsigned>(queues_.size()); }
+        uint64_t steals() const { return steals_; }
+
+    private:
+        // ڶ֮ճһУţC++14  vector ֤ alignas Ĭ϶룩
+        struct Queue {
+            std::mutex lock;
+            std::deque<uint32_t> items;
+            char pad[64];
+        };
+
+        std::vector<Queue> queues_;
+        std::atomic<uint64_t> pending_{ 0 };
+        std::atomic<uint64_t> steals_{ 0 };
+
+        bool popLocal(unsigned worker, uint32_t& item) {
+            Queue& q = queues_[worker];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.items.empty()) return false;
+            item = q.items.back();
+            q.items.pop_back();
+            return true;
+        }
+
+        bool steal(unsigned worker, Xoshiro256& rng, uint32_t& item) {
+            unsigned n = threads();
+            unsigned start = rng.bounded(n);
+            for (unsigned k = 0; k < n; ++k) {
+                unsigned victim = (start + k) % n;
+                if (victim == worker) continue;
+                Queue& q = queues_[victim];
+                std::lock_guard<std::mutex> guard(q.lock);
+                if (q.items.empty()) continue;
+                item = q.items.front();
+                q.items.pop_front();
+                steals_++;
+                return true;
+            }
+            return false;
+        }
+
+        void work(unsigned worker, const Handler& handler) {
+            Xoshiro256 rng(0x5EED, worker);
+            uint32_t item;
+            while (pending_.load() > 0) {
+                if (popLocal(worker, item) || steal(worker, rng, item)) {
+                    handler(worker, item);
+                    pending_--;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    struct SimulationConfig {
+        int tables = 1000;
+        engine::TableConfig table;          // ÿλäע
+        uint64_t handsPerTable = 1000;
+        int handsPerStep = 64;              // ÿε
+        int32_t startingStack = 10000;      // 벻һäʱظ
+        uint64_t seed = 1;
+        unsigned threads = 0;               // 0 ʾȫ
+        std::vector<int> lineup;            // λʹõĲԱţΪʱֻ
+    };
+
+    struct PolicyStats {
+        std::string name;
+        uint64_t seatHands = 0;   // λƣ
+        int64_t net = 0;          // Ӯ
+        uint64_t rebuys = 0;
+
+        double bbPer100(int32_t bigBlind) const {
+            return seatHands ? 100.0 * net / bigBlind / seatHands : 0;
+        }
+    };
+
+    struct SimulationReport {
+        uint64_t hands = 0;
+        double seconds = 0;
+        double handsPerSecond = 0;
+        uint64_t steals = 0;
+        uint64_t checksum = 0;                      // ժҪ߳͵޹
+        std::vector<PolicyStats> policies;
+        std::vector<std::vector<double>> flow;      // flow[i][j] i Ӳ j Ӯõĳ
+        std::vector<uint64_t> handsPerWorker;
+    };
+
+    // ģÿӵķƺͻ˾ֻøӺž
+    // ÿĽ߳˳޹أͳۼӵ߳Լۼϲ
+    class Simulator {
+    public:
+        Simulator(const SimulationConfig& config, std::vector<const BotPolicy*> policies)
+            : config_(config), policies_(std::move(policies)) {
+            if (policies_.empty()) throw std::invalid_argument("Simulator needs at least one policy");
+            if (config.tables <= 0 || config.handsPerStep <= 0) throw std::invalid_argument("Invalid simulation size");
+            if (config.table.seats < 2 || config.table.seats > engine::MAX_SEATS) {
+                throw std::invalid_argument("Table must have 2 to 10 seats");
+            }
+            if (!config.lineup.empty() && static_cast<int>(config.lineup.size()) != config.table.seats) {
+                throw std::invalid_argument("Lineup must name a policy for every seat");
+            }
+            for (int p : config.lineup) {
+                if (p < 0 || p >= static_cast<int>(policies_.size())) throw std::invalid_argument("Unknown policy in lineup");
+            }
+        }
+
+        SimulationReport run() {
+            auto start = std::chrono::steady_clock::now();
+            unsigned threadCount = config_.threads ? config_.threads : std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+
+            tables_.assign(config_.tables, Table());
+            for (int t = 0; t < config_.tables; ++t) setupTable(t);
+            // ÿ߳һݣԷ
+            std::vector<std::unique_ptr<Accumulator>> acc;
+            for (unsigned w = 0; w < threadCount; ++w) acc.emplace_back(new Accumulator(policies_.size()));
+
+            WorkStealingScheduler scheduler(threadCount);
+            std::vector<uint32_t> items(config_.tables);
+            for (int t = 0; t < config_.tables; ++t) items[t] = static_cast<uint32_t>(t);
+            scheduler.run(items, [&](unsigned worker, uint32_t t) {
+                Table& table = tables_[t];
+                uint64_t left = config_.handsPerTable - table.handsPlayed;
+                int n = static_cast<int>(std::min<uint64_t>(left, config_.handsPerStep));
+                for (int i = 0; i < n; ++i) playHand(table, *acc[worker]);
+                if (table.handsPlayed < config_.handsPerTable) scheduler.push(worker, t);
+            });
+
+            SimulationReport report;
+            report.policies.resize(policies_.size());
+            report.flow.assign(policies_.size(), std::vector<double>(policies_.size(), 0.0));
+            for (size_t p = 0; p < policies_.size(); ++p) report.policies[p].name = policies_[p]->name();
+            for (const auto& a : acc) {
+                report.hands += a->hands;
+                report.handsPerWorker.push_back(a->hands);
+                for (size_t p = 0; p < policies_.size(); ++p) {
+                    report.policies[p].seatHands += a->policy(p).seatHands;
+                    report.policies[p].net += a->policy(p).net;
+                    report.policies[p].rebuys += a->policy(p).rebuys;
+                    for (size_t q = 0; q < policies_.size(); ++q) report.flow[p][q] += a->flowAt(p * policies_.size() + q);
+                }
+            }
+            for (const Table& table : tables_) report.checksum = report.checksum * 0x100000001B3ULL ^ table.digest;
+            report.steals = scheduler.steals();
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report.handsPerSecond = report.seconds > 0 ? report.hands / report.seconds : 0;
+            return report;
+        }
+
+    private:
+        // һӵȫ״̬֮ճһ
+        struct Table {
+            Xoshiro256 rng;
+            int32_t stacks[engine::MAX_SEATS] = { 0 };
+            int policy[engine::MAX_SEATS] = { 0 };
+            int button = 0;
+            uint64_t handsPlayed = 0;
+            uint64_t digest = 0;      // ÿֵľӮλ
+            char pad[64] = {};
+        };
+
+        // ÿ̵߳ͳƣϲÿ̵߳䣻ǰ
+        // һвãͬ߳ÿдļͬһϣҲĶ
+        struct Accumulator {
+            static const size_t POLICY_PAD = (64 + sizeof(PolicyStats) - 1) / sizeof(PolicyStats);
+            static const size_t FLOW_PAD = 64 / sizeof(double);
+
+            char before[64];
+            uint64_t hands = 0;
+            std::vector<PolicyStats> policies;
+            std::vector<double> flow;   // [ӮҲ][Ҳ]
+            char after[64];
+
+            explicit Accumulator(size_t n) : policies(n + 2 * POLICY_PAD), flow(n * n + 2 * FLOW_PAD) {}
+
+            PolicyStats& policy(size_t p) { return policies[POLICY_PAD + p]; }
+            const PolicyStats& policy(size_t p) const { return policies[POLICY_PAD + p]; }
+            double& flowAt(size_t i) { return flow[FLOW_PAD + i]; }
+            double flowAt(size_t i) const { return flow[FLOW_PAD + i]; }
+        };
+
+        SimulationConfig config_;
+        std::vector<const BotPolicy*> policies_;
+        std::vector<Table> tables_;
+
+        void setupTable(int t) {
+            Table& table = tables_[t];
+            table.rng = Xoshiro256(config_.seed, static_cast<uint64_t>(t));
+            for (int i = 0; i < config_.table.seats; ++i) {
+                table.stacks[i] = config_.startingStack;
+                table.policy[i] = config_.lineup.empty()
+                    ? static_cast<int>((t + i) % policies_.size())
+                    : config_.lineup[i];
+            }
+            table.button = static_cast<int>(table.rng.bounded(static_cast<uint32_t>(config_.table.seats)));
+        }
+
+        void playHand(Table& table, Accumulator& acc) {
+            int seats = config_.table.seats;
+            for (int i = 0; i < seats; ++i) {
+                if (table.stacks[i] < config_.table.bigBlind) {
+                    table.stacks[i] = config_.startingStack;
+                    acc.policy(table.policy[i]).rebuys++;
+                }
+            }
+
+            HandState s = GameEngine::startHand(config_.table, table.stacks, table.button, table.rng);
+            while (!s.finished()) {
+                GameEngine::apply(s, policies_[table.policy[s.toAct]]->act(s, table.rng));
+            }
+
+            int32_t net[engine::MAX_SEATS];
+            double gains = 0;
+            for (int i = 0; i < seats; ++i) {
+                net[i] = s.seat[i].won - s.seat[i].committed;
+                table.stacks[i] = s.seat[i].stack;
+                PolicyStats& p = acc.policy(table.policy[i]);
+                p.seatHands++;
+                p.net += net[i];
+                if (net[i] > 0) gains += net[i];
+                table.digest = (table.digest ^ static_cast<uint32_t>(net[i])) * 0x100000001B3ULL;
+            }
+            // ÿλҵĳ밴ӮӮõıָӮ
+            size_t n = policies_.size();
+            for (int w = 0; w < seats && gains > 0; ++w) {
+                if (net[w] <= 0) continue;
+                for (int l = 0; l < seats; ++l) {
+                    if (net[l] < 0) acc.flowAt(table.policy[w] * n + table.policy[l]) += -net[l] * (net[w] / gains);
+                }
+            }
+
+            table.button = (table.button + 1) % seats;
+            table.handsPlayed++;
+            acc.hands++;
+        }
+    };
+
+}
+
+#endif
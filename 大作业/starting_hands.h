@@ -0,0 +1,77 @@
+#ifndef STARTING_HANDS_H
+#define STARTING_HANDS_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+
+namespace rules {
+
+    using Poker::Card;
+    using Poker::CardSet;
+    using Poker::HoleCards;
+    using Poker::Suit;
+    using Poker::rankIndex;
+    using Poker::rankFromIndex;
+
+    // 169ƣ13x13 񣬶ڶԽϣ
+    // ͬΪ *13+ͣͬΪ *13+ߣ rankIndexTwo=0 ... Ace=12
+    class StartingHands {
+    public:
+        static const int COUNT = 169;
+
+        static int classIndex(int high, int low, bool suited) {
+            if (high < low) std::swap(high, low);
+            return suited ? high * 13 + low : low * 13 + high;
+        }
+
+        static int classIndex(CardSet hole) {
+            if (hole.size() != 2) throw std::invalid_argument("Starting hand must be two cards");
+            Card a = hole.popFirst();
+            Card b = hole.popFirst();
+            return classIndex(rankIndex(a.rank()), rankIndex(b.rank()), a.suit() == b.suit());
+        }
+
+        static int classIndex(const HoleCards& hole) {
+            return classIndex(hole.getCardSet());
+        }
+
+        static bool isPair(int cls) { return cls / 13 == cls % 13; }
+        static bool isSuited(int cls) { return cls / 13 > cls % 13; }
+
+        static int highRank(int cls) { return std::max(cls / 13, cls % 13); }
+        static int lowRank(int cls) { return std::min(cls / 13, cls % 13); }
+
+        //  "AA""AKs""72o"
+        static std::string name(int cls) {
+            static const char RANKS[] = "23456789TJQKA";
+            std::string s;
+            s += RANKS[highRank(cls)];
+            s += RANKS[lowRank(cls)];
+            if (!isPair(cls)) s += isSuited(cls) ? 's' : 'o';
+            return s;
+        }
+
+        // ȫϣ6֡ͬ4֡ͬ12֣
+        static std::vector<CardSet> combos(int cls) {
+            std::vector<CardSet> result;
+            int high = highRank(cls), low = lowRank(cls);
+            for (int s1 = 0; s1 < 4; ++s1) {
+                for (int s2 = 0; s2 < 4; ++s2) {
+                    if (isPair(cls) ? s2 <= s1 : (isSuited(cls) ? s1 != s2 : s1 == s2)) continue;
+                    CardSet hand;
+                    hand.add(Card(static_cast<Suit>(s1), rankFromIndex(high)));
+                    hand.add(Card(static_cast<Suit>(s2), rankFromIndex(low)));
+                    result.push_back(hand);
+                }
+            }
+            return result;
+        }
+    };
+
+}
+
+#endif
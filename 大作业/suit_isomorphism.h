@@ -0,0 +1,141 @@
+#ifndef SUIT_ISOMORPHISM_H
+#define SUIT_ISOMORPHISM_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "poker.h"
+#include "HoleCards.h"
+#include "texas_holdem_evaluator.h"
+
+namespace rules {
+
+    // 淶ľ棺ɫûͬľõͬ
+    struct CanonicalHand {
+        CardSet hole;
+        CardSet board;
+        uint8_t suitMap[4];   // ԭɫ -> 淶ɫ
+    };
+
+    // ɫֻͬɫõľڲϵȼۣ緭ֻ 1755 ֣ 22100 ֣
+    // ÿֻɫãûɫĵƵ, ûɫĹƵӴС±Żɫ
+    // ͬĻɫԻκͬľ涼õͬһ
+    //
+    // 淶Ϊ 64 λ
+    //   bit 0-51  ƣÿֻɫ 13 λ
+    //   bit 52-57 Сĵƣɫ*13+ûʱΪ 63
+    //   bit 58-63 ϴĵ
+    class SuitIsomorphism {
+    public:
+        static const int FLOP_CLASSES = 1755;
+        static const uint64_t NO_CARD = 63;
+
+        static CanonicalHand canonicalize(CardSet hole, CardSet board) {
+            if (hole.size() > 2) throw std::invalid_argument("At most two hole cards");
+            if (!(hole & board).empty()) throw std::invalid_argument("Hole cards overlap the board");
+
+            // ֵƵڸλƵڵλ
+            uint32_t key[4];
+            int order[4] = { 0, 1, 2, 3 };
+            for (int s = 0; s < 4; ++s) key[s] = static_cast<uint32_t>(hole.suitMask(s)) << 16 | board.suitMask(s);
+            for (int i = 1; i < 4; ++i) {
+                for (int j = i; j > 0 && key[order[j]] > key[order[j - 1]]; --j) std::swap(order[j], order[j - 1]);
+            }
+
+            CanonicalHand result;
+            for (int i = 0; i < 4; ++i) {
+                int s = order[i];
+                result.suitMap[s] = static_cast<uint8_t>(i);
+                result.hole |= CardSet(static_cast<uint64_t>(hole.suitMask(s)) << (16 * i));
+                result.board |= CardSet(static_cast<uint64_t>(board.suitMask(s)) << (16 * i));
+            }
+            return result;
+        }
+
+        static uint64_t index(CardSet hole, CardSet board) {
+            CanonicalHand c = canonicalize(hole, board);
+            uint64_t lo = NO_CARD, hi = NO_CARD;
+            if (!c.hole.empty()) lo = compactIndex(c.hole.popFirst());
+            if (!c.hole.empty()) hi = compactIndex(c.hole.popFirst());
+            return compact(c.board) | lo << 52 | hi << 58;
+        }
+
+        static uint64_t index(const HoleCards& hole, const std::vector<Card>& board) {
+            return index(hole.getCardSet(), CardSet::of(board));
+        }
+
+        // ɹ淶ŻԭĴ淶ƣ
+        static void unindex(uint64_t index, CardSet& hole, CardSet& board) {
+            board = expand(index & COMPACT_MASK);
+            hole = CardSet();
+            uint64_t lo = (index >> 52) & 63, hi = (index >> 58) & 63;
+            if (lo != NO_CARD) hole.add(cardFromCompact(static_cast<int>(lo)));
+            if (hi != NO_CARD) hole.add(cardFromCompact(static_cast<int>(hi)));
+        }
+
+        // ƣŹƣĽձ 0-1754
+        static int flopIndex(CardSet flop) {
+            if (flop.size() != 3) throw std::invalid_argument("Flop must be three cards");
+            const std::vector<uint64_t>& flops = flopTable();
+            return static_cast<int>(std::lower_bound(flops.begin(), flops.end(), index(CardSet(), flop)) - flops.begin());
+        }
+
+        static CardSet flopFromIndex(int i) {
+            if (i < 0 || i >= FLOP_CLASSES) throw std::out_of_range("Flop index out of range");
+            CardSet hole, board;
+            unindex(flopTable()[i], hole, board);
+            return board;
+        }
+
+    private:
+        static const uint64_t COMPACT_MASK = (1ULL << 52) - 1;
+
+        static int compactIndex(const Card& card) {
+            return (card.index() >> 4) * 13 + (card.index() & 15);
+        }
+
+        static Card cardFromCompact(int i) {
+            return Card::fromIndex((i / 13) * 16 + i % 13);
+        }
+
+        // ÿֻɫ 16 λѹ 13 λ
+        static uint64_t compact(CardSet set) {
+            uint64_t bits = 0;
+            for (int s = 0; s < 4; ++s) bits |= static_cast<uint64_t>(set.suitMask(s)) << (13 * s);
+            return bits;
+        }
+
+        static CardSet expand(uint64_t bits) {
+            uint64_t set = 0;
+            for (int s = 0; s < 4; ++s) set |= ((bits >> (13 * s)) & 0x1FFF) << (16 * s);
+            return CardSet(set);
+        }
+
+        // ȫƵĹ淶ţ±꼴Ʊţ״ʹʱ
+        static const std::vector<uint64_t>& flopTable() {
+            static const std::vector<uint64_t> table = []() {
+                std::vector<Card> deck = CardSet::fullDeck().toCards();
+                std::vector<uint64_t> keys;
+                for (size_t a = 0; a < deck.size(); ++a) {
+                    for (size_t b = a + 1; b < deck.size(); ++b) {
+                        for (size_t c = b + 1; c < deck.size(); ++c) {
+                            CardSet flop;
+                            flop.add(deck[a]);
+                            flop.add(deck[b]);
+                            flop.add(deck[c]);
+                            keys.push_back(index(CardSet(), flop));
+                        }
+                    }
+                }
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+                return keys;
+            }();
+            return table;
+        }
+    };
+
+}
+
+#endif
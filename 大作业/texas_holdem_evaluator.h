@@ -4,6 +4,8 @@
 #include <vector>
 #include <algorithm>
 #include <map>
+#include <cstdint>
+#include <initializer_list>
 #include "poker.h"  // ֮ǰ˿ƶ
 #include"HoleCards.h"
 using namespace Poker;
@@ -23,38 +25,84 @@ namespace rules{
         ROYAL_FLUSH     // ʼͬ˳
     };
 
-    // ͷ
-    struct HandStrength {
-        HandRank rank;
-        std::vector<Rank> kickers;
+    const int HAND_RANK_COUNT = 10;
 
-        bool operator>(const HandStrength& other) const {
-            if (rank != other.rank)
-                return rank > other.rank;
-            for (size_t i = 0; i < kickers.size(); ++i) {
-                if (kickers[i] != other.kickers[i])
-                    return kickers[i] > other.kickers[i];
-            }
-            return false;
+    // СA ƣΪ 14
+    constexpr int rankValue(Rank r) {
+        return r == Rank::Ace ? 14 : static_cast<int>(r);
+    }
+
+    // ͷΪһ32λ
+    //   bit 20-23 ͣbit 16-19 ... bit 0-3 Ϊ5߽ŵ2-140ʾûУ
+    // ԽԽ󣬱ȽֻһȽϣκζѷ
+    class HandStrength {
+    public:
+        static const int MAX_KICKERS = 5;
+
+        constexpr HandStrength() = default;
+        constexpr explicit HandStrength(uint32_t packed) : value_(packed) {}
+        constexpr HandStrength(HandRank rank, std::initializer_list<Rank> kickers)
+            : value_(pack(rank, kickers)) {}
+
+        constexpr uint32_t value() const { return value_; }
+        constexpr HandRank rank() const { return static_cast<HandRank>(value_ >> 20); }
+
+        constexpr int kickerCount() const {
+            int n = 0;
+            while (n < MAX_KICKERS && kickerValue(n) != 0) ++n;
+            return n;
+        }
+
+        //  i ߽ţ0 ΪҪһ
+        constexpr Rank kicker(int i) const {
+            return kickerValue(i) == 14 ? Rank::Ace : static_cast<Rank>(kickerValue(i));
+        }
+
+        // ׷һ߽ţ5ʱ
+        HandStrength& addKicker(Rank r) {
+            int n = kickerCount();
+            if (n < MAX_KICKERS) value_ |= static_cast<uint32_t>(rankValue(r)) << (16 - 4 * n);
+            return *this;
         }
 
-        bool operator<(const HandStrength& other) const {
-            if (rank != other.rank)
-                return rank < other.rank;  
-            for (size_t i = 0; i < kickers.size(); ++i) {
-                if (kickers[i] != other.kickers[i])
-                    return kickers[i] < other.kickers[i];
+        constexpr bool operator<(HandStrength other) const { return value_ < other.value_; }
+        constexpr bool operator>(HandStrength other) const { return value_ > other.value_; }
+        constexpr bool operator<=(HandStrength other) const { return value_ <= other.value_; }
+        constexpr bool operator>=(HandStrength other) const { return value_ >= other.value_; }
+        constexpr bool operator==(HandStrength other) const { return value_ == other.value_; }
+        constexpr bool operator!=(HandStrength other) const { return value_ != other.value_; }
+
+    private:
+        uint32_t value_ = 0;
+
+        constexpr int kickerValue(int i) const {
+            return static_cast<int>((value_ >> (16 - 4 * i)) & 0xF);
+        }
+
+        static constexpr uint32_t pack(HandRank rank, std::initializer_list<Rank> kickers) {
+            uint32_t value = static_cast<uint32_t>(rank) << 20;
+            int i = 0;
+            for (Rank r : kickers) {
+                if (i == MAX_KICKERS) break;
+                value |= static_cast<uint32_t>(rankValue(r)) << (16 - 4 * i);
+                ++i;
             }
-            return false;
+            return value;
         }
     };
 
+    static_assert(sizeof(HandStrength) == 4, "HandStrength must stay packed");
+
     class Evaluator {
     public:
 
         static HandStrength evaluateHand(const std::vector<Card>& cards) {
+            POKER_TIMED(EvaluateHand, 64);
+            // 5ʱֱӷеƣֻܳɶ///ƣ
+            if (cards.size() <= 5) return analyzeCombo(cards);
+
             std::vector<std::vector<Card>> combinations = generateCombinations(cards, 5);
-            HandStrength best;
+            HandStrength best = analyzeCombo(combinations[0]);
             for (auto& combo : combinations) {
                 HandStrength current = analyzeCombo(combo);
                 if (current > best) best = current;
@@ -62,15 +110,102 @@ namespace rules{
             return best;
         }
 
+        // λ汾ֱӰɫжͣö
+        static HandStrength evaluateHand(CardSet cards) {
+            POKER_TIMED(EvaluateHand, 64);
+            uint16_t s0 = cards.suitMask(0), s1 = cards.suitMask(1);
+            uint16_t s2 = cards.suitMask(2), s3 = cards.suitMask(3);
+
+            uint16_t any = s0 | s1 | s2 | s3;
+            uint16_t two = (s0 & s1) | (s2 & s3) | ((s0 | s1) & (s2 | s3));        // 2
+            uint16_t three = ((s0 & s1) & (s2 | s3)) | ((s2 & s3) & (s0 | s1));    // 3
+            uint16_t four = s0 & s1 & s2 & s3;
+
+            uint16_t flush = 0;
+            for (uint16_t m : { s0, s1, s2, s3 }) {
+                if (bitCount(m) >= 5) flush = m;
+            }
+
+            if (flush) {
+                int high = straightHigh(flush);
+                if (high) {
+                    return HandStrength(high == 14 ? HandRank::ROYAL_FLUSH : HandRank::STRAIGHT_FLUSH,
+                        { valueToRank(high) });
+                }
+            }
+
+            if (four) {
+                int q = highestBit(four);
+                HandStrength result(HandRank::FOUR_OF_A_KIND, { rankFromIndex(q) });
+                appendTop(result, any & ~(1 << q), 1);
+                return result;
+            }
+
+            if (three && bitCount(two) >= 2) {
+                int t = highestBit(three);
+                return HandStrength(HandRank::FULL_HOUSE,
+                    { rankFromIndex(t), rankFromIndex(highestBit(two & ~(1 << t))) });
+            }
+
+            if (flush) {
+                HandStrength result(HandRank::FLUSH, {});
+                appendTop(result, flush, 5);
+                return result;
+            }
+
+            int high = straightHigh(any);
+            if (high) {
+                return HandStrength(HandRank::STRAIGHT, { valueToRank(high) });
+            }
+
+            if (three) {
+                int t = highestBit(three);
+                HandStrength result(HandRank::THREE_OF_A_KIND, { rankFromIndex(t) });
+                appendTop(result, any & ~(1 << t), 2);
+                return result;
+            }
+
+            if (bitCount(two) >= 2) {
+                HandStrength result(HandRank::TWO_PAIR, {});
+                appendTop(result, two, 2);
+                uint16_t pairs = static_cast<uint16_t>((1 << rankIndex(result.kicker(0))) |
+                    (1 << rankIndex(result.kicker(1))));
+                appendTop(result, any & ~pairs, 1);
+                return result;
+            }
+
+            if (two) {
+                int p = highestBit(two);
+                HandStrength result(HandRank::ONE_PAIR, { rankFromIndex(p) });
+                appendTop(result, any & ~(1 << p), 3);
+                return result;
+            }
+
+            HandStrength result(HandRank::HIGH_CARD, {});
+            appendTop(result, any, 5);
+            return result;
+        }
+
         static std::vector<int> determineWinners(
             const std::vector<std::vector<Card>>& allHands, 
             const std::vector<Card>& communityCards
         ) {
-            std::vector<HandStrength> strengths;
+            std::vector<CardSet> hands;
             for (const auto& hand : allHands) {  // ʹconstñ
-                auto fullHand = hand;  // 
-                fullHand.insert(fullHand.end(), communityCards.begin(), communityCards.end());
-                strengths.push_back(evaluateHand(fullHand));
+                hands.push_back(CardSet::of(hand));
+            }
+            return determineWinners(hands, CardSet::of(communityCards));
+        }
+
+        // 빫ƺϲֻһΰλ
+        static std::vector<int> determineWinners(
+            const std::vector<CardSet>& allHands,
+            CardSet communityCards
+        ) {
+            POKER_TIMED(DetermineWinners, 16);
+            std::vector<HandStrength> strengths;
+            for (CardSet hand : allHands) {
+                strengths.push_back(evaluateHand(hand | communityCards));
             }
 
             std::vector<int> winners;
@@ -87,91 +222,109 @@ namespace rules{
 
     private:
         // ͷ
-        static HandStrength analyzeCombo(const std::vector<Card>& cards) {
+        static HandStrength analyzeCombo(const std::vector<Card>& combo) {
+            if (combo.empty()) return HandStrength();
+
+            std::vector<Card> cards = combo;
             sortByRank(cards);
 
-            bool isFlush = checkFlush(cards);
-            bool isStraight = checkStraight(cards);
+            bool isFlush = cards.size() == 5 && checkFlush(cards);
+            bool isStraight = cards.size() == 5 && checkStraight(cards);
             auto counts = countRanks(cards);
 
-            HandStrength result;
+            // ˳ӵĶƣA-2-3-4-5 ʱΪ5
+            Rank straightHigh = cards[0].rank();
+            if (isStraight && cards[0].rank() == Rank::Ace && cards[1].rank() == Rank::Five)
+                straightHigh = Rank::Five;
 
-            // ʼͬ˳ͬ + ˳ + Ϊ10
-            if (isFlush && isStraight && cards[0].rank() == Rank::Ten) {
-                result.rank = HandRank::ROYAL_FLUSH;
-                result.kickers = { Rank::Ace };
-                return result;
+            // ʼͬ˳ͬ + ˳ + ΪA
+            if (isFlush && isStraight && straightHigh == Rank::Ace) {
+                return HandStrength(HandRank::ROYAL_FLUSH, { Rank::Ace });
             }
 
             // ͬ˳
             if (isFlush && isStraight) {
-                result.rank = HandRank::STRAIGHT_FLUSH;
-                result.kickers = { cards[0].rank() };
-                return result;
+                return HandStrength(HandRank::STRAIGHT_FLUSH, { straightHigh });
             }
 
             // 
             if (counts[0].second == 4) {
-                result.rank = HandRank::FOUR_OF_A_KIND;
-                result.kickers = { counts[0].first, counts[1].first };
-                return result;
+                return rankKickers(HandRank::FOUR_OF_A_KIND, counts);
             }
 
             // «
-            if (counts[0].second == 3 && counts[1].second == 2) {
-                result.rank = HandRank::FULL_HOUSE;
-                result.kickers = { counts[0].first, counts[1].first };
-                return result;
+            if (counts[0].second == 3 && counts.size() > 1 && counts[1].second == 2) {
+                return rankKickers(HandRank::FULL_HOUSE, counts);
             }
 
             // ͬ
             if (isFlush) {
-                result.rank = HandRank::FLUSH;
-                for (const auto& c : cards) result.kickers.push_back(c.rank());
+                HandStrength result(HandRank::FLUSH, {});
+                for (const auto& c : cards) result.addKicker(c.rank());
                 return result;
             }
 
             // ˳
             if (isStraight) {
-                result.rank = HandRank::STRAIGHT;
-                result.kickers = { cards[0].rank() };
-                return result;
+                return HandStrength(HandRank::STRAIGHT, { straightHigh });
             }
 
             // 
             if (counts[0].second == 3) {
-                result.rank = HandRank::THREE_OF_A_KIND;
-                result.kickers = { counts[0].first, counts[1].first, counts[2].first };
-                return result;
+                return rankKickers(HandRank::THREE_OF_A_KIND, counts);
             }
 
             // 
-            if (counts[0].second == 2 && counts[1].second == 2) {
-                result.rank = HandRank::TWO_PAIR;
-                result.kickers = { counts[0].first, counts[1].first, counts[2].first };
-                return result;
+            if (counts[0].second == 2 && counts.size() > 1 && counts[1].second == 2) {
+                return rankKickers(HandRank::TWO_PAIR, counts);
             }
 
             // һ
             if (counts[0].second == 2) {
-                result.rank = HandRank::ONE_PAIR;
-                result.kickers = { counts[0].first, counts[1].first, counts[2].first, counts[3].first };
-                return result;
+                return rankKickers(HandRank::ONE_PAIR, counts);
             }
 
             // 
-            result.rank = HandRank::HIGH_CARD;
-            for (const auto& c : cards) result.kickers.push_back(c.rank());
+            HandStrength result(HandRank::HIGH_CARD, {});
+            for (const auto& c : cards) result.addKicker(c.rank());
             return result;
         }
 
         // 
-        static void sortByRank(std::vector<Card> cards) {
+        static Rank valueToRank(int value) {
+            return value == 14 ? Rank::Ace : static_cast<Rank>(value);
+        }
+
+        // ˳ӶƵ2-14û˳ӷ0A ͬʱλ A-2-3-4-5
+        static int straightHigh(uint16_t mask) {
+            uint32_t m = (static_cast<uint32_t>(mask) << 1) | ((mask >> 12) & 1);
+            uint32_t run = m & (m << 1) & (m << 2) & (m << 3) & (m << 4);
+            return run ? highestBit(run) + 1 : 0;
+        }
+
+        // Ӹߵ׷ n 
+        static void appendTop(HandStrength& strength, uint32_t mask, int n) {
+            mask &= CardSet::RANK_MASK;
+            for (int i = 0; i < n && mask; ++i) {
+                int r = highestBit(mask);
+                strength.addKicker(rankFromIndex(r));
+                mask &= ~(1u << r);
+            }
+        }
+
+        static void sortByRank(std::vector<Card>& cards) {
             std::sort(cards.rbegin(), cards.rend(), [](const Card& a, const Card& b) {
-                return static_cast<int>(a.rank()) < static_cast<int>(b.rank());
+                return rankValue(a.rank()) < rankValue(b.rank());
                 });
         }
 
+        // , źõĵΪ߽˳
+        static HandStrength rankKickers(HandRank rank, const std::vector<std::pair<Rank, int>>& counts) {
+            HandStrength result(rank, {});
+            for (const auto& p : counts) result.addKicker(p.first);
+            return result;
+        }
+
         static bool checkFlush(const std::vector<Card>& cards) {
             Suit s = cards[0].suit();
             for (const auto& c : cards) {
@@ -180,13 +333,13 @@ namespace rules{
             return true;
         }
 
-        static bool checkStraight(std::vector<Card> cards) {
+        static bool checkStraight(const std::vector<Card>& cards) {
             // A-2-3-4-5
             bool hasAce = cards[0].rank() == Rank::Ace;
             if (hasAce) {
                 bool lowStraight = true;
                 for (int i = 1; i < 5; ++i) {
-                    if (cards[i].rank() != static_cast<Rank>(5 - i)) {
+                    if (cards[i].rank() != static_cast<Rank>(6 - i)) {
                         lowStraight = false;
                         break;
                     }
@@ -195,8 +348,8 @@ namespace rules{
             }
 
             for (size_t i = 0; i < cards.size() - 1; ++i) {
-                if (static_cast<int>(cards[i].rank()) - 1 !=
-                    static_cast<int>(cards[i + 1].rank())) {
+                if (rankValue(cards[i].rank()) - 1 !=
+                    rankValue(cards[i + 1].rank())) {
                     return false;
                 }
             }
@@ -217,7 +370,7 @@ namespace rules{
             std::sort(result.rbegin(), result.rend(),
                 [](const auto& a, const auto& b) {
                     if (a.second != b.second) return a.second < b.second;
-                    return static_cast<int>(a.first) < static_cast<int>(b.first);
+                    return rankValue(a.first) < rankValue(b.first);
                 });
 
             return result;
@@ -0,0 +1,60 @@
+﻿// 离线训练单挑 CFR 策略
+// 用法：cfr_train [--out=cfr_strategy.bin] [--iterations=N] [--threads=N] [--seed=N]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <exception>
+#include "cfr.h"
+
+using namespace ai;
+
+int main(int argc, char** argv) {
+    CfrTrainerOptions options;
+    std::string out = "cfr_strategy.bin";
+    uint64_t iterations = 200000;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--out=", 6) == 0) out = arg + 6;
+        else if (std::strncmp(arg, "--iterations=", 13) == 0) iterations = std::strtoull(arg + 13, nullptr, 10);
+        else if (std::strncmp(arg, "--threads=", 10) == 0) options.threads = static_cast<unsigned>(std::atoi(arg + 10));
+        else if (std::strncmp(arg, "--seed=", 7) == 0) options.seed = std::strtoull(arg + 7, nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: %s [--out=file] [--iterations=N] [--threads=N] [--seed=N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) {
+        std::fprintf(stderr, "--iterations must be positive\n");
+        return 2;
+    }
+
+    try {
+        CfrTrainer trainer(options);
+        std::printf("%d infosets, %.1f KB of regret tables\n", CfrAbstraction::infosetCount(), trainer.memoryBytes() / 1024.0);
+
+        // 分段训练，每段报告一次进度
+        const uint64_t STEPS = 10;
+        uint64_t done = 0;
+        double seconds = 0;
+        for (uint64_t step = 1; step <= STEPS; ++step) {
+            uint64_t target = iterations * step / STEPS;
+            if (target == done) continue;
+            CfrTrainingStats stats = trainer.train(target - done);
+            done = target;
+            seconds += stats.seconds;
+            std::printf("%10llu iterations, %8.0f it/s, %6.1f nodes/it\n", static_cast<unsigned long long>(done),
+                stats.iterationsPerSecond, static_cast<double>(stats.nodes) / stats.iterations);
+        }
+
+        trainer.write(out);
+        CfrStrategy strategy = CfrStrategy::open(out);
+        size_t bytes = sizeof(CfrFileHeader) + static_cast<size_t>(strategy.header().infosets) * ABSTRACT_ACTIONS * sizeof(float);
+        std::printf("wrote %s (%.1f KB) in %.1f s, %.0f it/s\n", out.c_str(), bytes / 1024.0, seconds, done / seconds);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+﻿// 批量统计牌谱文件
+// 用法：hh_stats [--threads=N] [--json] [--min-hands=N] 文件...
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <exception>
+#include "hand_analytics.h"
+
+using namespace history;
+
+namespace {
+
+    const char* RANK_NAMES[rules::HAND_RANK_COUNT] = {
+        "high card", "one pair", "two pair", "three of a kind", "straight",
+        "flush", "full house", "four of a kind", "straight flush", "royal flush"
+    };
+    const char* STREET_NAMES[AnalyticsReport::STREETS] = { "preflop", "flop", "turn", "river" };
+    const char* ACTION_NAMES[AnalyticsReport::ACTION_TYPES] = { "fold", "check", "call", "raise", "allin" };
+
+    double ratio(double a, double b) { return b > 0 ? a / b : 0.0; }
+
+    std::string potBucketName(int b) {
+        char buf[32];
+        double lo = b > 0 ? AnalyticsReport::potBucketLimit(b - 1) : 0;
+        if (b == AnalyticsReport::POT_BUCKETS - 1) std::snprintf(buf, sizeof(buf), ">%g", lo);
+        else std::snprintf(buf, sizeof(buf), "%g-%g", lo, AnalyticsReport::potBucketLimit(b));
+        return buf;
+    }
+
+    void printText(const AnalyticsReport& r, uint64_t minHands, double seconds, uint64_t bytes) {
+        std::printf("%llu hands, %llu showdowns (%llu re-evaluated), %.2f s, %.0f MB/s\n",
+            static_cast<unsigned long long>(r.hands), static_cast<unsigned long long>(r.showdowns),
+            static_cast<unsigned long long>(r.reevaluated), seconds, ratio(bytes / 1e6, seconds));
+        if (r.skipped) std::printf("%llu corrupt records skipped\n", static_cast<unsigned long long>(r.skipped));
+
+        std::printf("\nstarting hand     dealt    win%%   bb/100\n");
+        for (int cls = 0; cls < rules::StartingHands::COUNT; ++cls) {
+            const StartingHandStats& s = r.startingHands[cls];
+            if (s.dealt == 0 || s.dealt < minHands) continue;
+            std::printf("%-12s %10llu  %6.2f  %7.1f\n", rules::StartingHands::name(cls).c_str(),
+                static_cast<unsigned long long>(s.dealt), 100.0 * ratio(s.won, s.dealt), 100.0 * ratio(s.netBB, s.dealt));
+        }
+
+        uint64_t ranked = 0;
+        for (uint64_t n : r.showdownRanks) ranked += n;
+        std::printf("\nshowdown hand          count   freq%%\n");
+        for (int k = 0; k < rules::HAND_RANK_COUNT; ++k) {
+            std::printf("%-16s %12llu  %6.2f\n", RANK_NAMES[k],
+                static_cast<unsigned long long>(r.showdownRanks[k]), 100.0 * ratio(r.showdownRanks[k], ranked));
+        }
+
+        std::printf("\npot (bb)               hands   freq%%   (mean %.1f bb)\n", ratio(r.potSumBB, r.hands));
+        for (int b = 0; b < AnalyticsReport::POT_BUCKETS; ++b) {
+            std::printf("%-16s %12llu  %6.2f\n", potBucketName(b).c_str(),
+                static_cast<unsigned long long>(r.potBuckets[b]), 100.0 * ratio(r.potBuckets[b], r.hands));
+        }
+
+        std::printf("\naction               count   EV (bb)\n");
+        for (int s = 0; s < AnalyticsReport::STREETS; ++s) {
+            for (int a = 0; a < AnalyticsReport::ACTION_TYPES; ++a) {
+                const ActionStats& st = r.actions[s][a];
+                if (st.count == 0) continue;
+                std::string name = std::string(STREET_NAMES[s]) + " " + ACTION_NAMES[a];
+                std::printf("%-14s %12llu  %8.3f\n", name.c_str(),
+                    static_cast<unsigned long long>(st.count), ratio(st.netBB, st.count));
+            }
+        }
+    }
+
+    void printJson(const AnalyticsReport& r, uint64_t minHands, double seconds) {
+        std::printf("{\n  \"hands\": %llu,\n  \"showdowns\": %llu,\n  \"reevaluated\": %llu,\n  \"skipped\": %llu,\n"
+            "  \"seconds\": %.3f,\n",
+            static_cast<unsigned long long>(r.hands), static_cast<unsigned long long>(r.showdowns),
+            static_cast<unsigned long long>(r.reevaluated), static_cast<unsigned long long>(r.skipped), seconds);
+
+        std::printf("  \"startingHands\": [");
+        bool first = true;
+        for (int cls = 0; cls < rules::StartingHands::COUNT; ++cls) {
+            const StartingHandStats& s = r.startingHands[cls];
+            if (s.dealt == 0 || s.dealt < minHands) continue;
+            std::printf("%s\n    {\"hand\": \"%s\", \"dealt\": %llu, \"won\": %llu, \"netBB\": %.3f}", first ? "" : ",",
+                rules::StartingHands::name(cls).c_str(), static_cast<unsigned long long>(s.dealt),
+                static_cast<unsigned long long>(s.won), s.netBB);
+            first = false;
+        }
+        std::printf("\n  ],\n  \"showdownRanks\": {");
+        for (int k = 0; k < rules::HAND_RANK_COUNT; ++k) {
+            std::printf("%s\"%s\": %llu", k ? ", " : "", RANK_NAMES[k], static_cast<unsigned long long>(r.showdownRanks[k]));
+        }
+        std::printf("},\n  \"potBuckets\": [");
+        for (int b = 0; b < AnalyticsReport::POT_BUCKETS; ++b) {
+            std::printf("%s{\"bb\": \"%s\", \"hands\": %llu}", b ? ", " : "", potBucketName(b).c_str(),
+                static_cast<unsigned long long>(r.potBuckets[b]));
+        }
+        std::printf("],\n  \"potMeanBB\": %.3f,\n  \"actions\": [", ratio(r.potSumBB, r.hands));
+        first = true;
+        for (int s = 0; s < AnalyticsReport::STREETS; ++s) {
+            for (int a = 0; a < AnalyticsReport::ACTION_TYPES; ++a) {
+                const ActionStats& st = r.actions[s][a];
+                if (st.count == 0) continue;
+                std::printf("%s\n    {\"street\": \"%s\", \"action\": \"%s\", \"count\": %llu, \"evBB\": %.4f}",
+                    first ? "" : ",", STREET_NAMES[s], ACTION_NAMES[a],
+                    static_cast<unsigned long long>(st.count), ratio(st.netBB, st.count));
+                first = false;
+            }
+        }
+        std::printf("\n  ]\n}\n");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bool json = false;
+    uint64_t minHands = 0;
+    bool badOption = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--threads=", 10) == 0) threads = static_cast<unsigned>(std::atoi(arg + 10));
+        else if (std::strcmp(arg, "--json") == 0) json = true;
+        else if (std::strncmp(arg, "--min-hands=", 12) == 0) minHands = std::strtoull(arg + 12, nullptr, 10);
+        else if (arg[0] == '-') badOption = true;
+        else paths.push_back(arg);
+    }
+    if (badOption || paths.empty()) {
+        std::fprintf(stderr, "usage: %s [--threads=N] [--json] [--min-hands=N] file...\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        AnalyticsReport report;
+        uint64_t bytes = 0;
+        for (const auto& path : paths) {
+            HandHistoryReader reader(path);
+            report.merge(HandAnalytics::run(reader, threads));
+            bytes += HandHistoryReader::offsetOf(reader.size());
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (json) printJson(report, minHands, seconds);
+        else printText(report, minHands, seconds, bytes);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+﻿// 离线生成翻牌前胜率表
+// 用法：preflop_gen [--out=preflop.bin] [--trials=N] [--threads=N] [--seed=N]
+//       preflop_gen --check=preflop.bin   校验文件并打印部分结果
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include "preflop_table.h"
+
+using namespace rules;
+
+namespace {
+
+    int check(const std::string& path) {
+        auto start = std::chrono::steady_clock::now();
+        PreflopTable table = PreflopTable::open(path);
+        double openUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (!table.verify()) {
+            std::fprintf(stderr, "%s: checksum mismatch\n", path.c_str());
+            return 1;
+        }
+        const PreflopFileHeader& h = table.header();
+        std::printf("%s: version %u, %llu trials per entry, seed %llu, opened in %.1f us\n", path.c_str(), h.version,
+            static_cast<unsigned long long>(h.trials), static_cast<unsigned long long>(h.seed), openUs);
+
+        const int AA = StartingHands::classIndex(12, 12, false);
+        const int AKs = StartingHands::classIndex(12, 11, true);
+        const int KK = StartingHands::classIndex(11, 11, false);
+        const int SEVEN_TWO = StartingHands::classIndex(5, 0, false);
+        for (int cls : { AA, AKs, KK, SEVEN_TWO }) {
+            std::printf("%-4s", StartingHands::name(cls).c_str());
+            for (int opponents = 1; opponents <= PREFLOP_MAX_OPPONENTS; ++opponents) {
+                std::printf(" %.3f", table.equity(cls, opponents));
+            }
+            std::printf("\n");
+        }
+        std::printf("AA vs KK %.3f, AKs vs 72o %.3f\n", table.headsUp(AA, KK), table.headsUp(AKs, SEVEN_TWO));
+        return 0;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    PreflopTableBuilder::Options options;
+    std::string out = "preflop.bin";
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--out=", 6) == 0) out = arg + 6;
+        else if (std::strncmp(arg, "--trials=", 9) == 0) options.trials = std::strtoull(arg + 9, nullptr, 10);
+        else if (std::strncmp(arg, "--threads=", 10) == 0) options.threads = static_cast<unsigned>(std::atoi(arg + 10));
+        else if (std::strncmp(arg, "--seed=", 7) == 0) options.seed = std::strtoull(arg + 7, nullptr, 10);
+        else if (std::strncmp(arg, "--check=", 8) == 0) return check(arg + 8);
+        else {
+            std::fprintf(stderr, "usage: %s [--out=file] [--trials=N] [--threads=N] [--seed=N] | --check=file\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.trials == 0) {
+        std::fprintf(stderr, "--trials must be positive\n");
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    PreflopTableBuilder::write(out, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("wrote %s in %.1f s\n", out.c_str(), seconds);
+    return check(out);
+}
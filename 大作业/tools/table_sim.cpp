@@ -0,0 +1,101 @@
+﻿// 多桌机器人对战模拟
+// 用法：table_sim [--tables=N] [--hands=N] [--seats=N] [--threads=N] [--seed=N]
+//                 [--bots=calling-station,loose-random,tight-aggressive,cfr] [--strategy=cfr_strategy.bin]
+//                 [--metrics=text|json]（需要以 POKER_METRICS 编译）
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <exception>
+#include "simulator.h"
+
+using namespace sim;
+
+int main(int argc, char** argv) {
+    SimulationConfig config;
+    std::string bots = "calling-station,loose-random,tight-aggressive";
+    std::string strategyPath = "cfr_strategy.bin";
+    std::string metricsFormat;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--tables=", 9) == 0) config.tables = std::atoi(arg + 9);
+        else if (std::strncmp(arg, "--hands=", 8) == 0) config.handsPerTable = std::strtoull(arg + 8, nullptr, 10);
+        else if (std::strncmp(arg, "--seats=", 8) == 0) config.table.seats = std::atoi(arg + 8);
+        else if (std::strncmp(arg, "--threads=", 10) == 0) config.threads = static_cast<unsigned>(std::atoi(arg + 10));
+        else if (std::strncmp(arg, "--seed=", 7) == 0) config.seed = std::strtoull(arg + 7, nullptr, 10);
+        else if (std::strncmp(arg, "--bots=", 7) == 0) bots = arg + 7;
+        else if (std::strncmp(arg, "--strategy=", 11) == 0) strategyPath = arg + 11;
+        else if (std::strcmp(arg, "--metrics=text") == 0 || std::strcmp(arg, "--metrics=json") == 0) metricsFormat = arg + 10;
+        else {
+            std::fprintf(stderr, "usage: %s [--tables=N] [--hands=N] [--seats=N] [--threads=N] [--seed=N] "
+                "[--bots=a,b,...] [--strategy=file] [--metrics=text|json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        ai::CfrStrategy strategy;
+        bool hasStrategy = false;
+        std::vector<std::unique_ptr<BotPolicy>> owned;
+        std::vector<const BotPolicy*> policies;
+        size_t start = 0;
+        while (start <= bots.size()) {
+            size_t end = bots.find(',', start);
+            if (end == std::string::npos) end = bots.size();
+            std::string name = bots.substr(start, end - start);
+            start = end + 1;
+            if (name.empty()) continue;
+            if (name == "calling-station") owned.emplace_back(new CallingStation);
+            else if (name == "loose-random") owned.emplace_back(new LooseRandom);
+            else if (name == "tight-aggressive") owned.emplace_back(new TightAggressive);
+            else if (name == "cfr") {
+                if (config.table.seats != 2) throw std::invalid_argument("The cfr bot only plays heads-up tables");
+                if (!hasStrategy) strategy = ai::CfrStrategy::open(strategyPath);
+                hasStrategy = true;
+                owned.emplace_back(new CfrBot(strategy));
+            }
+            else throw std::invalid_argument("Unknown bot: " + name);
+            policies.push_back(owned.back().get());
+        }
+
+        Simulator simulator(config, policies);
+        metrics::Snapshot before = metrics::Registry::snapshot();
+        SimulationReport report = simulator.run();
+        metrics::Snapshot counted = metrics::Registry::snapshot().since(before);
+
+        int32_t bb = config.table.bigBlind;
+        std::printf("%d tables x %llu hands, %d seats, %zu threads\n", config.tables,
+            static_cast<unsigned long long>(config.handsPerTable), config.table.seats, report.handsPerWorker.size());
+        std::printf("%llu hands in %.2f s, %.0f hands/s, %llu steals, checksum %016llx\n\n",
+            static_cast<unsigned long long>(report.hands), report.seconds, report.handsPerSecond,
+            static_cast<unsigned long long>(report.steals), static_cast<unsigned long long>(report.checksum));
+
+        std::printf("%-18s %12s %14s %10s %8s\n", "bot", "seat-hands", "net chips", "bb/100", "rebuys");
+        for (const PolicyStats& p : report.policies) {
+            std::printf("%-18s %12llu %14lld %10.2f %8llu\n", p.name.c_str(), static_cast<unsigned long long>(p.seatHands),
+                static_cast<long long>(p.net), p.bbPer100(bb), static_cast<unsigned long long>(p.rebuys));
+        }
+
+        std::printf("\nchip flow (row won from column, bb):\n%-18s", "");
+        for (const PolicyStats& p : report.policies) std::printf(" %16s", p.name.c_str());
+        std::printf("\n");
+        for (size_t i = 0; i < report.policies.size(); ++i) {
+            std::printf("%-18s", report.policies[i].name.c_str());
+            for (size_t j = 0; j < report.policies.size(); ++j) std::printf(" %16.0f", report.flow[i][j] / bb);
+            std::printf("\n");
+        }
+
+        if (!metricsFormat.empty()) {
+            if (!metrics::Registry::enabled()) std::fprintf(stderr, "\nbuilt without POKER_METRICS, no metrics recorded\n");
+            else if (metricsFormat == "json") std::printf("\n%s\n", counted.json().c_str());
+            else std::printf("\n%s", counted.text().c_str());
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -3,282 +3,291 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
 #include "ks.h"
 #include "poker.h"
-#include "HoleCards.h"
-#include "texas_holdem_evaluator.h"
+#include "game_engine.h"
+#include "hand_history.h"
+#include "cfr.h"
+#include "decision.h"
+#include "incremental_hand.h"
+#include "outs.h"
+#include "equity_cache.h"
+#include "renderer.h"
+#include "easyx_renderer.h"
 
 using namespace Poker;
 using namespace rules;
+using engine::GameEngine;
+using engine::Action;
 
 const int WIDTH = 1500;
 const int HEIGHT = 900;
 
 class PokerGame {
 private:
-    Deck deck;
-    HoleCards playerHand;
-    HoleCards computerHand;
-    std::vector<Card> communityCards;
-    int pot = 0;
-    int playerChips = 1000;
-    int computerChips = 1000;
+    engine::TableConfig table;          // 两人桌，盲注 $50/$100
+    engine::HandState hand;
+    int32_t chips[2] = { 1000, 1000 };
+    int button = 0;
+    Xoshiro256 rng{ randomSeed() };
     bool gameEnd = false;
+    render::Compositor compositor;      // 只重绘和上一帧不同的区域
+    history::HandRecorder recorder;     // 每手牌写入牌谱文件
+    std::unique_ptr<history::HandHistoryWriter> historyWriter;   // 打不开或写入出错时为空，不再记录
+    ai::AnytimeDecider decider;         // 限时决策，默认每次 5 毫秒
+    ai::CfrStrategy strategy;           // 由 cfr_train 生成的策略
+    bool hasStrategy = false;
+    IncrementalHand playerHand;         // 玩家当前牌型和听牌，每街只更新一次
+    OutsResult playerOuts;              // 玩家的出牌，底牌或公共牌变了才重算
+    CardSet outsCards;
+    EquityCache equityCache;            // 同构局面的胜率只模拟一次，提示用
+    CachedEquity playerEquity;          // 玩家对一个随机对手的胜率，底牌或公共牌变了才查
+    CardSet equityCards;
+    uint64_t handId = 0;
 
 private:
-    // 辅助函数：将牌面转换为图片的文件名
-    TCHAR* getCardImageName(const Card& card) {
-        static TCHAR filename[50];
-
-        // 转换花色
-        const TCHAR* suitStr;
-        switch (card.suit()) {
-        case Suit::Hearts:   suitStr = _T("heart");   break;
-        case Suit::Diamonds: suitStr = _T("diamond"); break;
-        case Suit::Clubs:    suitStr = _T("club");    break;
-        case Suit::Spades:   suitStr = _T("spade");   break;
-        default:             suitStr = _T("unknown");
-        }
-
-        // 转换点数
-        const TCHAR* rankStr;
-        switch (card.rank()) {
-        case Rank::Ace:   rankStr = _T("A");  break;
-        case Rank::Two:   rankStr = _T("2");  break;
-        case Rank::Three: rankStr = _T("3");  break;
-        case Rank::Four:  rankStr = _T("4");  break;
-        case Rank::Five:  rankStr = _T("5");  break;
-        case Rank::Six:   rankStr = _T("6");  break;
-        case Rank::Seven: rankStr = _T("7");  break;
-        case Rank::Eight: rankStr = _T("8");  break;
-        case Rank::Nine:  rankStr = _T("9");  break;
-        case Rank::Ten:   rankStr = _T("10"); break;
-        case Rank::Jack:  rankStr = _T("J");  break;
-        case Rank::Queen: rankStr = _T("Q");  break;
-        case Rank::King:  rankStr = _T("K");  break;
-        default:          rankStr = _T("?");  
-        }
-
-        _stprintf_s(filename, _T("%s%s.png"), suitStr, rankStr);
-        return filename;
+    // 场景元素编号
+    enum ItemId {
+        CHIP_INFO = 1,
+        COMPUTER_CARD = 10,   // 10-11
+        BOARD_CARD = 20,      // 20-24
+        PLAYER_CARD = 30,     // 30-31
+        CALL_BUTTON = 40,
+        RAISE_BUTTON,
+        FOLD_BUTTON,
+        CALL_LABEL,
+        RAISE_LABEL,
+        FOLD_LABEL,
+        RESULT_TEXT = 50,
+        HAND_HINT,
+        EQUITY_HINT
+    };
+
+    static const wchar_t* categoryName(HandRank rank) {
+        static const wchar_t* names[HAND_RANK_COUNT] = {
+            L"高牌", L"一对", L"两对", L"三条", L"顺子", L"同花", L"葫芦", L"四条", L"同花顺", L"皇家同花顺"
+        };
+        return names[static_cast<int>(rank)];
     }
 
-    void drawCard(int x, int y, const Card& card, bool faceUp = true) {
-        IMAGE cardImg;
-        TCHAR imgPath[MAX_PATH] = { 0 };
+    void addCard(render::Scene& scene, int id, int x, int y, const Card& card, bool faceUp = true) {
+        int slot = faceUp ? card.index() : render::AtlasLayout::CARD_BACK;
+        scene.add(render::Item::sprite(id, slot, x, y, CARD_WIDTH, CARD_HEIGHT));
+    }
 
-        // 生成图片路径
-        if (faceUp) {
-            _stprintf_s(imgPath, _T("%s%s"),
-                CARD_IMAGE_BASE_PATH,
-                getCardImageName(card));
+    // 由当前牌局状态生成一帧；reveal 时亮出电脑手牌并显示结果
+    render::Scene buildScene(bool reveal, const std::wstring& result) {
+        render::Scene scene;
+        const render::Color white = render::rgb(255, 255, 255);
+
+        // 筹码信息
+        wchar_t chipInfo[100];
+        swprintf(chipInfo, 100, L"玩家筹码: $%d  底池: $%d  电脑筹码: $%d",
+            hand.seat[PLAYER].stack, hand.pot(), hand.seat[COMPUTER].stack);
+        scene.add(render::Item::label(CHIP_INFO, render::Rect(50, 50, 650, 70), chipInfo, white));
+
+        // 电脑手牌，结算前为背面
+        std::vector<Card> computerCards = hand.seat[COMPUTER].hole.toCards();
+        addCard(scene, COMPUTER_CARD, 600, 100, computerCards[0], reveal);
+        addCard(scene, COMPUTER_CARD + 1, 800, 100, computerCards[1], reveal);
+
+        // 公共牌
+        int startX = 400;
+        for (int i = 0; i < hand.boardCount; i++) {
+            addCard(scene, BOARD_CARD + i, startX + i * 150, 300, hand.boardCard(i));
         }
-        else {
-            _stprintf_s(imgPath, _T("%s%s"),
-                CARD_IMAGE_BASE_PATH,
-                CARD_BACK_IMAGE);
-        }
-
-        // 加载图片并检查结果
-        bool loadSuccess = false;
 
-#ifdef _EASYX_VER_ // 新版检测
-        loadSuccess = loadimage(&cardImg, imgPath, CARD_WIDTH, CARD_HEIGHT);
-#else              // 旧版始终返回成功
-        loadimage(&cardImg, imgPath, CARD_WIDTH, CARD_HEIGHT);
-        loadSuccess = true;
-#endif
-
-        if (loadSuccess) {
-            putimage(x, y, &cardImg);
+        // 玩家手牌
+        std::vector<Card> playerCards = hand.seat[PLAYER].hole.toCards();
+        addCard(scene, PLAYER_CARD, 600, 600, playerCards[0]);
+        addCard(scene, PLAYER_CARD + 1, 800, 600, playerCards[1]);
+
+        // 牌型提示
+        playerHand.advanceTo(hand.boardSet());
+        std::wstring hint = std::wstring(L"牌型: ") + categoryName(playerHand.category());
+        const DrawStatus& draws = playerHand.draws();
+        if (draws.flushDraw) hint += L"  同花听牌";
+        if (draws.openEnded) hint += L"  两头顺听牌";
+        else if (draws.gutshot) hint += L"  卡顺听牌";
+        CardSet board = hand.boardSet();
+        if (board.size() == 3 || board.size() == 4) {
+            CardSet hole = hand.seat[PLAYER].hole;
+            if ((hole | board) != outsCards) {
+                Outs::compute(&hole, 1, board, playerOuts);
+                outsCards = hole | board;
+            }
+            hint += L"  出牌 " + std::to_wstring(playerOuts.players[0].count()) + L" 张";
         }
-        else {
-            drawErrorCard(x, y, _T("Load Failed"));
+        scene.add(render::Item::label(HAND_HINT, render::Rect(1000, 650, 1450, 670), hint, white));
+
+        CardSet hole = hand.seat[PLAYER].hole;
+        if ((hole | board) != equityCards) {
+            EquityOptions options;
+            options.maxTrials = 5000;
+            options.threads = 1;
+            options.seed = 1;
+            playerEquity = equityCache.equity(hole, board, 1, options);
+            equityCards = hole | board;
         }
-    }
-
-    // 错误卡片绘制函数
-    void drawErrorCard(int x, int y, LPCTSTR msg) {
-        setfillcolor(HSVtoRGB(0, 0.8, 1)); // 亮红色
-        fillrectangle(x, y, x + CARD_WIDTH, y + CARD_HEIGHT);
-
-        settextcolor(BLACK);
-        settextstyle(14, 0, _T("Consolas"));
-        outtextxy(x + 5, y + 5, msg);
-    }
-    const TCHAR* suitSymbol(Suit s) {
-        switch (s) {
-        case Suit::Hearts: return _T("♥");
-        case Suit::Diamonds: return _T("♦");
-        case Suit::Clubs: return _T("♣");
-        case Suit::Spades: return _T("♠");
-        default: return _T("");
+        wchar_t equityHint[50];
+        swprintf(equityHint, 50, L"胜率（对随机一手）: %.0f%%", playerEquity.equity * 100);
+        scene.add(render::Item::label(EQUITY_HINT, render::Rect(1000, 680, 1450, 700), equityHint, white));
+
+        // 操作按钮
+        const render::Color buttonColor = render::rgb(70, 130, 180);
+        scene.add(render::Item::button(CALL_BUTTON, render::Rect(200, 750, 400, 830), buttonColor));
+        scene.add(render::Item::button(RAISE_BUTTON, render::Rect(450, 750, 650, 830), buttonColor));
+        scene.add(render::Item::button(FOLD_BUTTON, render::Rect(700, 750, 900, 830), buttonColor));
+
+        wchar_t callLabel[50] = L"过牌";
+        engine::LegalActions legal = GameEngine::legalActions(hand);
+        if (legal.canCall) swprintf(callLabel, 50, L"跟注 ($%d)", legal.callAmount);
+        scene.add(render::Item::label(CALL_LABEL, render::Rect(250, 770, 400, 790), callLabel, white));
+        scene.add(render::Item::label(RAISE_LABEL, render::Rect(500, 770, 650, 790), L"加注", white));
+        scene.add(render::Item::label(FOLD_LABEL, render::Rect(750, 770, 900, 790), L"弃牌", white));
+
+        if (!result.empty()) {
+            scene.add(render::Item::label(RESULT_TEXT, render::Rect(600, 480, 1000, 500), result, white));
         }
+        return scene;
     }
 
 public:
     void run() {
-        initgraph(WIDTH, HEIGHT);
-        BeginBatchDraw();
-
-        // 加载背景
-        IMAGE bgImg;
-        loadimage(&bgImg, _T("D:\\大作业\\Source\\background.jpg"), WIDTH, HEIGHT);
+        render::EasyXRenderer renderer(WIDTH, HEIGHT, _T("D:\\大作业\\Source\\background.jpg"));
+        loadStrategy();
+        openHistory();
 
-        deck.shuffle();
-        dealInitialCards();
+        startHand();
 
         while (!gameEnd) {
-            cleardevice();
-            putimage(0, 0, &bgImg);
-
-            // 绘制筹码信息
-            settextcolor(WHITE);
-            TCHAR chipInfo[100];
-            _stprintf_s(chipInfo, _T("玩家筹码: $%d  底池: $%d  电脑筹码: $%d"),
-                playerChips, pot, computerChips);
-            outtextxy(50, 50, chipInfo);
-
-            // 绘制电脑手牌（背面）
-            drawCard(600, 100, Card(Suit::Spades, Rank::Ace), false);
-            drawCard(800, 100, Card(Suit::Hearts, Rank::King), false);
-
-            // 绘制公共牌
-            int startX = 400;
-            for (size_t i = 0; i < communityCards.size(); i++) {
-                drawCard(startX + i * 150, 300, communityCards[i]);
-            }
-
-            // 绘制玩家手牌
-            if (playerHand.hasCards()) {
-                drawCard(600, 600, playerHand.getCards()[0]);
-                drawCard(800, 600, playerHand.getCards()[1]);
-            }
-
-            // 绘制操作按钮
-            setfillcolor(RGB(70, 130, 180));
-            fillroundrect(200, 750, 400, 830, 10, 10); // 跟注
-            fillroundrect(450, 750, 650, 830, 10, 10); // 加注
-            fillroundrect(700, 750, 900, 830, 10, 10); // 弃牌
-
-            settextcolor(WHITE);
-            outtextxy(250, 770, _T("跟注 ($50)"));
-            outtextxy(500, 770, _T("加注"));
-            outtextxy(750, 770, _T("弃牌"));
+            // 状态没变时不会重绘
+            compositor.render(renderer, buildScene(false, L""));
 
-            FlushBatchDraw();
+            if (hand.toAct == COMPUTER) computerAction();
+            else processInput();
 
-            processInput();
+            if (hand.finished()) endHand(renderer);
         }
-
-        EndBatchDraw();
-        closegraph();
     }
 
 private:
-    void dealInitialCards() {
-        playerHand.receiveCards(deck);
-        computerHand.receiveCards(deck);
-        pot = 100;  // 盲注
-        playerChips -= 50;
-        computerChips -= 50;
+    static const int PLAYER = 0;
+    static const int COMPUTER = 1;
+
+    void startHand() {
+        int32_t stacks[2] = { chips[PLAYER], chips[COMPUTER] };
+        hand = GameEngine::startHand(table, stacks, button, rng);
+        playerHand = IncrementalHand(hand.seat[PLAYER].hole);
+        recorder.begin(hand, handId++);
+    }
+
+    // 一手结束后显示结果，双方都还有筹码就换庄继续
+    void endHand(render::Renderer& renderer) {
+        saveHistory();
+        showResult(renderer);
+        chips[PLAYER] = hand.seat[PLAYER].stack;
+        chips[COMPUTER] = hand.seat[COMPUTER].stack;
+        if (chips[PLAYER] == 0 || chips[COMPUTER] == 0) {
+            gameEnd = true;
+            return;
+        }
+        button = 1 - button;
+        startHand();
     }
 
+    // 等待玩家点击（阻塞等待消息，空闲时不占用CPU）
     void processInput() {
-        if (MouseHit()) {
-            MOUSEMSG msg = GetMouseMsg();
-            if (msg.uMsg == WM_LBUTTONDOWN) {
-                // 处理跟注
-                if (msg.x > 200 && msg.x < 400 && msg.y > 750 && msg.y < 830) {
-                    playerChips -= 50;
-                    pot += 50;
-                    computerAction();
-                    nextStage();
-                }
-                // 处理加注
-                else if (msg.x > 450 && msg.x < 650 && msg.y > 750 && msg.y < 830) {
-                    // 简化加注逻辑
-                    playerChips -= 100;
-                    pot += 100;
-                    computerAction();
-                    nextStage();
-                }
-                // 处理弃牌
-                else if (msg.x > 700 && msg.x < 900 && msg.y > 750 && msg.y < 830) {
-                    gameEnd = true;
-                    showResult(true);
-                }
+        MOUSEMSG msg = GetMouseMsg();
+        if (msg.uMsg == WM_LBUTTONDOWN) {
+            engine::LegalActions legal = GameEngine::legalActions(hand);
+            // 处理跟注
+            if (msg.x > 200 && msg.x < 400 && msg.y > 750 && msg.y < 830) {
+                recorder.apply(hand, legal.canCheck ? Action::check() : Action::call());
+            }
+            // 处理加注（按最小加注额）
+            else if (msg.x > 450 && msg.x < 650 && msg.y > 750 && msg.y < 830) {
+                if (legal.canRaise) recorder.apply(hand, Action::raiseTo(legal.minRaiseTo));
+            }
+            // 处理弃牌
+            else if (msg.x > 700 && msg.x < 900 && msg.y > 750 && msg.y < 830) {
+                recorder.apply(hand, Action::fold());
             }
         }
     }
 
-    void computerAction() {
-        // 简单AI逻辑：80%跟注，20%加注
-        int action = rand() % 10;
-        if (action < 8) {
-            computerChips -= 50;
-            pot += 50;
+    // 没有策略文件时电脑用限时决策
+    void loadStrategy() {
+        try {
+            strategy = ai::CfrStrategy::open("cfr_strategy.bin");
+            hasStrategy = true;
         }
-        else {
-            computerChips -= 100;
-            pot += 100;
+        catch (const std::exception&) {
+            hasStrategy = false;
         }
     }
 
-    void nextStage() {
-        static int stage = 0;
-        switch (stage++) {
-        case 0: dealCommunityCards(3); break; // 翻牌
-        case 1: dealCommunityCards(1); break; // 转牌
-        case 2: dealCommunityCards(1);        // 河牌
-            showResult(false);
-            gameEnd = true;
-            break;
+    // 牌谱文件不是本程序的格式、版本不符或目录不可写时，不记录牌谱，照常游戏
+    void openHistory() {
+        try {
+            historyWriter.reset(new history::HandHistoryWriter("hand_history.bin"));
+        }
+        catch (const std::exception&) {
+            historyWriter.reset();
         }
     }
 
-    void dealCommunityCards(int num) {
-        for (int i = 0; i < num; i++) {
-            communityCards.push_back(deck.deal());
+    // 写盘失败（如磁盘已满）就停止记录
+    void saveHistory() {
+        const history::HandRecord& record = recorder.finish(hand);
+        if (!historyWriter) return;
+        try {
+            historyWriter->append(record);
+            historyWriter->flush();
+        }
+        catch (const std::exception&) {
+            historyWriter.reset();
         }
     }
 
-    void showResult(bool folded) {
-        cleardevice();
-
-        // 显示所有牌
-        drawCard(600, 100, computerHand.getCards()[0]);
-        drawCard(800, 100, computerHand.getCards()[1]);
-
-        // 胜负判定
-        std::vector<std::vector<Card>> hands = {
-            playerHand.getCards(),
-            computerHand.getCards()
-        };
+    void computerAction() {
+        if (hasStrategy) {
+            recorder.apply(hand, strategy.choose(hand, rng));
+            return;
+        }
 
-        auto winners = Evaluator::determineWinners(hands, communityCards);
+        // 没有策略文件时在时间预算内估计各动作的收益
+        recorder.apply(hand, decider.decide(hand, rng).action);
+    }
 
-        settextcolor(WHITE);
-        if (folded) {
-            outtextxy(600, 400, _T("玩家弃牌，电脑获胜!"));
+    void showResult(render::Renderer& renderer) {
+        // 胜负由引擎在摊牌时判定
+        std::wstring result;
+        if (!hand.seat[PLAYER].inHand) {
+            result = L"玩家弃牌，电脑获胜!";
+        }
+        else if (!hand.seat[COMPUTER].inHand) {
+            result = L"电脑弃牌，玩家获胜!";
         }
-        else if (winners[0] == 0) {
-            outtextxy(600, 400, _T("玩家获胜!"));
-            playerChips += pot;
+        else if (hand.seat[PLAYER].won > hand.seat[COMPUTER].won) {
+            result = L"玩家获胜!";
+        }
+        else if (hand.seat[PLAYER].won < hand.seat[COMPUTER].won) {
+            result = L"电脑获胜!";
         }
         else {
-            outtextxy(600, 400, _T("电脑获胜!"));
-            computerChips += pot;
+            result = L"平局，平分底池!";
         }
 
-        FlushBatchDraw();
+        // 显示所有牌
+        compositor.render(renderer, buildScene(true, result));
         Sleep(3000);
     }
 };
 
 int main() {
-    srand(static_cast<unsigned>(time(nullptr)));
     PokerGame game;
     game.run();
     return 0;
-}
\ No newline at end of file
+}